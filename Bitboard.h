@@ -18,6 +18,8 @@ namespace Bitboards {
     static constexpr BitBoard ROW_2 = 0x000000000000FF00ULL;
     static constexpr BitBoard ROW_3 = 0x0000000000FF0000ULL;
     static constexpr BitBoard ROW_4 = 0x00000000FF000000ULL;
+    static constexpr BitBoard ROW_5 = 0x000000FF00000000ULL;
+    static constexpr BitBoard ROW_6 = 0x0000FF0000000000ULL;
     static constexpr BitBoard ROW_7 = 0x00FF000000000000ULL;
     static constexpr BitBoard ROW_8 = 0xFF00000000000000ULL;
 
@@ -25,14 +27,23 @@ namespace Bitboards {
     static constexpr BitBoard FILE_AB = FILE_A | FILE_B;
     static constexpr BitBoard FILE_GH = FILE_G | FILE_H;
 
-    static BitBoard bit(const uint8_t &sq) { return 1ULL << sq; }
-    static uint8_t column_of(const uint8_t &sq) { return sq & 7; }
-    static uint8_t row_of(const uint8_t &sq) { return sq >> 3; }
+    static constexpr BitBoard bit(const uint8_t &sq) { return 1ULL << sq; }
+    static constexpr uint8_t column_of(const uint8_t &sq) { return sq & 7; }
+    static constexpr uint8_t row_of(const uint8_t &sq) { return sq >> 3; }
     static int popCount64(const BitBoard &x) { return __builtin_popcountll(x); }
     static int getPos(const int &row, const int &col) { return row * 8 + col; }
     static  int  lsb_index(const BitBoard& b){ return __builtin_ctzll(b); }
     static  void pop_lsb(BitBoard& b){ b &= (b - 1); }
 
+    /**
+     * Shift by a compile-time offset, positive towards row 8, negative towards row 1
+     */
+    template<int Offset>
+    static constexpr BitBoard shift(const BitBoard &b) {
+        if constexpr (Offset > 0) return b << Offset;
+        else return b >> -Offset;
+    }
+
     static std::vector<BitBoard> allSubsets(const BitBoard& mask) {
         std::vector<BitBoard> v;
         BitBoard s = mask;
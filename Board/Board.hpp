@@ -6,7 +6,9 @@
 
 #include "Zobrist.hpp"
 #include "../Bitboard.h"
+#include "PieceSquareTables.hpp"
 #include "../MoveGenerator/Move/Move.hpp"
+#include "../MoveGenerator/PreComputedMoves/PreComputedMoves.hpp"
 
 using namespace std;
 
@@ -27,6 +29,46 @@ enum PieceType {
 
 inline PieceColor opponentColor(const PieceColor color) { return color == WHITE ? BLACK : WHITE; }
 
+/**
+ * Everything in move generation and make/unmake which depends on the side to move,
+ * resolved at compile time.
+ */
+template<PieceColor Us>
+struct ColorTraits {
+    static constexpr PieceColor them = Us == WHITE ? BLACK : WHITE;
+
+    // pawn directions, "left" is towards file A
+    static constexpr int forward = Us == WHITE ? 8 : -8;
+    static constexpr int forwardLeft = Us == WHITE ? 7 : -9;
+    static constexpr int forwardRight = Us == WHITE ? 9 : -7;
+
+    static constexpr BitBoard promotionRow = Us == WHITE ? Bitboards::ROW_8 : Bitboards::ROW_1;
+    // row reached by a single push from which a double push continues
+    static constexpr BitBoard doublePushRow = Us == WHITE ? Bitboards::ROW_3 : Bitboards::ROW_6;
+
+    static constexpr int shortCastleRight = Us == WHITE ? 1 : 4;
+    static constexpr int longCastleRight = Us == WHITE ? 2 : 8;
+
+    static constexpr uint8_t kingFrom = Us == WHITE ? 4 : 60;
+    static constexpr uint8_t shortKingTo = Us == WHITE ? 6 : 62;
+    static constexpr uint8_t shortRookFrom = Us == WHITE ? 7 : 63;
+    static constexpr uint8_t shortRookTo = Us == WHITE ? 5 : 61;
+    static constexpr uint8_t longKingTo = Us == WHITE ? 2 : 58;
+    static constexpr uint8_t longRookFrom = Us == WHITE ? 0 : 56;
+    static constexpr uint8_t longRookTo = Us == WHITE ? 3 : 59;
+
+    // squares which have to be empty / not attacked (besides the king square) to castle
+    static constexpr BitBoard shortCastleEmpty = Us == WHITE ? 0x60ULL : 0x6000000000000000ULL;
+    static constexpr BitBoard shortCastleSafe = Us == WHITE ? 0x60ULL : 0x6000000000000000ULL;
+    static constexpr BitBoard longCastleEmpty = Us == WHITE ? 0x0EULL : 0x0E00000000000000ULL;
+    static constexpr BitBoard longCastleSafe = Us == WHITE ? 0x0CULL : 0x0C00000000000000ULL;
+
+    static constexpr BitBoard pawnAttacks(const BitBoard &pawns) {
+        return (Bitboards::shift<forwardLeft>(pawns) & ~Bitboards::FILE_H) |
+               (Bitboards::shift<forwardRight>(pawns) & ~Bitboards::FILE_A);
+    }
+};
+
 inline PieceType decodePromo(const Move::Promo promo) {
     switch (promo) {
         case Move::PR_KNIGHT:
@@ -40,12 +82,30 @@ inline PieceType decodePromo(const Move::Promo promo) {
     }
 }
 
+/**
+ * Check related data of the side to move
+ */
+struct CheckState {
+    // enemy pieces giving check to the king of the side to move
+    BitBoard checkers;
+    // pieces of either color standing alone between the king of [color] and an enemy slider
+    BitBoard blockersForKing[2];
+    // squares from which a piece of the side to move of the given type would check the enemy king
+    BitBoard checkSquares[6];
+};
+
 class Board {
 public:
     BitBoard pieces[2][6]{};
     BitBoard occupancy[2]{};
     BitBoard occupancyAll{};
     BitBoard zobrist{};
+    // pawns of both colors only / piece counts only
+    BitBoard pawnKey{};
+    BitBoard materialKey{};
+    // running evaluation sums from white's point of view
+    int materialScore = 0;
+    int pstScore = 0;
     int8_t pieceOn[64]{-1};
     PieceColor side = WHITE;
     int castle = 0;
@@ -53,7 +113,20 @@ public:
     int halfMove = 0;
     int fullMove = 1;
     uint8_t kingSq[2]{60, 4};
-    bool isCheck = false;
+
+    // attack maps are maintained once enableAttackMaps() was called
+    bool trackAttacks = false;
+
+private:
+    // computed on first use by getCheckState(), any piece change drops it
+    mutable CheckState checkState{};
+    mutable bool checkStateValid = false;
+
+    // squares changed since the attack maps were last brought up to date by getAttackedBy()
+    mutable BitBoard attacksDirty = 0;
+    // attacks of the piece standing on the square, 0 for empty squares
+    mutable BitBoard attacksFrom[64]{};
+    mutable BitBoard attackedBy[2]{};
 
 public:
     Board() {
@@ -63,24 +136,55 @@ public:
     ~Board() = default;
     Board(const Board &) noexcept = default;
 
+    [[nodiscard]] const CheckState &getCheckState() const {
+        if (!this->checkStateValid) {
+            this->computeCheckState();
+            this->checkStateValid = true;
+        }
+        return this->checkState;
+    }
+
+    [[nodiscard]] bool isCheck() const { return this->getCheckState().checkers != 0; }
+
+    /**
+     * Squares attacked by the color, pieces block sliders. Requires enableAttackMaps(),
+     * the squares changed since the last query are resolved here, once per any number of moves
+     */
+    [[nodiscard]] BitBoard getAttackedBy(const PieceColor &color) const {
+        if (this->attacksDirty) this->refreshAttacks();
+        return this->attackedBy[color];
+    }
+
+    [[nodiscard]] BitBoard getAttacksFrom(const uint8_t &position) const {
+        if (this->attacksDirty) this->refreshAttacks();
+        return this->attacksFrom[position];
+    }
+
     void setPiece(
         const PieceColor &color,
         const PieceType &type,
         const uint8_t &position
     ) {
-        const auto zobristInstance = Zobrist::instance();
-
         const BitBoard board = Bitboards::bit(position);
 
         this->pieceOn[position] = static_cast<int8_t>(color * 6 + type);
         this->pieces[color][type] |= board;
         this->occupancy[color] |= board;
         this->occupancyAll |= board;
-        this->zobrist ^= zobristInstance.pieceRnd[Zobrist::pieceIndexFrom(color, type)][position];
+        this->zobrist ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][position];
+        this->materialKey ^= zobristKeys.materialRnd[Zobrist::pieceIndexFrom(color, type)]
+                [Bitboards::popCount64(this->pieces[color][type])];
+        if (type == PAWN) this->pawnKey ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][position];
+        this->materialScore += PieceSquareTables::SCORES.material[color][type];
+        this->pstScore += PieceSquareTables::SCORES.square[color][type][position];
 
         if (type == KING) {
             this->kingSq[color] = position;
         }
+
+        this->checkStateValid = false;
+
+        if (this->trackAttacks) this->attacksDirty |= board;
     }
 
     void removePiece(
@@ -88,15 +192,23 @@ public:
         const PieceType &type,
         const uint8_t &position
     ) {
-        const auto zobristInstance = Zobrist::instance();
-
         const BitBoard board = Bitboards::bit(position);
 
+        this->materialKey ^= zobristKeys.materialRnd[Zobrist::pieceIndexFrom(color, type)]
+                [Bitboards::popCount64(this->pieces[color][type])];
+
         this->pieceOn[position] = -1;
         this->pieces[color][type] &= ~board;
         this->occupancy[color] &= ~board;
         this->occupancyAll &= ~board;
-        this->zobrist ^= zobristInstance.pieceRnd[Zobrist::pieceIndexFrom(color, type)][position];
+        this->zobrist ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][position];
+        if (type == PAWN) this->pawnKey ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][position];
+        this->materialScore -= PieceSquareTables::SCORES.material[color][type];
+        this->pstScore -= PieceSquareTables::SCORES.square[color][type][position];
+
+        this->checkStateValid = false;
+
+        if (this->trackAttacks) this->attacksDirty |= board;
     }
 
     void movePiece(
@@ -105,8 +217,6 @@ public:
         const uint8_t from,
         const uint8_t to
     ) {
-        const auto zobristInstance = Zobrist::instance();
-
         const BitBoard boardFrom = Bitboards::bit(from);
         const BitBoard boardTo = Bitboards::bit(to);
 
@@ -117,8 +227,14 @@ public:
         this->pieces[color][type] |= boardTo;
         this->occupancy[color] |= boardTo;
         this->occupancyAll |= boardTo;
-        this->zobrist ^= zobristInstance.pieceRnd[Zobrist::pieceIndexFrom(color, type)][from];
-        this->zobrist ^= zobristInstance.pieceRnd[Zobrist::pieceIndexFrom(color, type)][to];
+        this->zobrist ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][from];
+        this->zobrist ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][to];
+        if (type == PAWN) {
+            this->pawnKey ^= zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][from] ^
+                             zobristKeys.pieceRnd[Zobrist::pieceIndexFrom(color, type)][to];
+        }
+        this->pstScore += PieceSquareTables::SCORES.square[color][type][to] -
+                          PieceSquareTables::SCORES.square[color][type][from];
 
 
         this->pieceOn[to] = static_cast<int8_t>(color * 6 + type);
@@ -127,32 +243,145 @@ public:
         if (type == KING) {
             this->kingSq[color] = to;
         }
+
+        this->checkStateValid = false;
+
+        if (this->trackAttacks) this->attacksDirty |= boardFrom | boardTo;
     }
 
-    void clearCastleByMove(
-        const PieceColor &c,
-        const PieceType &type,
-        const uint8_t &from
-    ) {
-        if (type == KING) {
-            if (c == WHITE) this->castle &= ~(1 | 2);
-            else this->castle &= ~(4 | 8);
+    /**
+     * Compute the attack maps from scratch and keep them updated from now on
+     */
+    void enableAttackMaps() {
+        this->trackAttacks = true;
+
+        this->attacksDirty = ~0ULL;
+    }
+
+    /**
+     * Drop castle rights lost by a move touching from/to (king or rook moved, rook captured)
+     */
+    void updateCastleRights(const uint8_t &from, const uint8_t &to) {
+        this->castle &= CASTLE_RIGHTS_MASK[from] & CASTLE_RIGHTS_MASK[to];
+    }
+
+private:
+    void computeCheckState() const {
+        const PieceColor us = this->side;
+        const PieceColor them = opponentColor(us);
+        const uint8_t ourKing = this->kingSq[us];
+        const uint8_t theirKing = this->kingSq[them];
+        const BitBoard occ = this->occupancyAll;
+
+        // a pawn of ours attacks a square exactly when a pawn of theirs there would attack it back
+        const BitBoard *ourPawnAttacks = us == WHITE ? preComputedMoves.whitePawn : preComputedMoves.blackPawn;
+        const BitBoard *theirPawnAttacks = us == WHITE ? preComputedMoves.blackPawn : preComputedMoves.whitePawn;
+
+        this->checkState.checkers =
+                ((ourPawnAttacks[ourKing] & this->pieces[them][PAWN]) |
+                 (preComputedMoves.knight[ourKing] & this->pieces[them][KNIGHT]) |
+                 (preComputedMoves.getBishopAttacks(ourKing, occ) &
+                  (this->pieces[them][BISHOP] | this->pieces[them][QUEEN])) |
+                 (preComputedMoves.getRookAttacks(ourKing, occ) &
+                  (this->pieces[them][ROOK] | this->pieces[them][QUEEN])));
+
+        this->checkState.blockersForKing[WHITE] = this->sliderBlockers(WHITE);
+        this->checkState.blockersForKing[BLACK] = this->sliderBlockers(BLACK);
+
+        const BitBoard bishopChecks = preComputedMoves.getBishopAttacks(theirKing, occ);
+        const BitBoard rookChecks = preComputedMoves.getRookAttacks(theirKing, occ);
+
+        this->checkState.checkSquares[PAWN] = theirPawnAttacks[theirKing];
+        this->checkState.checkSquares[KNIGHT] = preComputedMoves.knight[theirKing];
+        this->checkState.checkSquares[BISHOP] = bishopChecks;
+        this->checkState.checkSquares[ROOK] = rookChecks;
+        this->checkState.checkSquares[QUEEN] = bishopChecks | rookChecks;
+        this->checkState.checkSquares[KING] = 0ULL;
+    }
+
+    /**
+     * A single piece of any color between the king and an enemy slider aligned with it is a blocker,
+     * our own blockers are pinned, the enemy's ones can give a discovered check
+     */
+    [[nodiscard]] BitBoard sliderBlockers(const PieceColor &kingColor) const {
+        const PieceColor enemy = opponentColor(kingColor);
+        const uint8_t king = this->kingSq[kingColor];
+
+        BitBoard snipers =
+                (preComputedMoves.getBishopAttacks(king, 0ULL) &
+                 (this->pieces[enemy][BISHOP] | this->pieces[enemy][QUEEN])) |
+                (preComputedMoves.getRookAttacks(king, 0ULL) &
+                 (this->pieces[enemy][ROOK] | this->pieces[enemy][QUEEN]));
+
+        BitBoard blockers = 0;
+        for (; snipers; Bitboards::pop_lsb(snipers)) {
+            const BitBoard between = preComputedMoves.between[king][Bitboards::lsb_index(snipers)] &
+                                     this->occupancyAll;
+            if (between && !(between & (between - 1))) blockers |= between;
         }
-        if (type == ROOK) {
-            if (c == WHITE && from == 0) this->castle &= ~2; // a1
-            if (c == WHITE && from == 7) this->castle &= ~1; // h1
-            if (c == BLACK && from == 56) this->castle &= ~8; // a8
-            if (c == BLACK && from == 63) this->castle &= ~4; // h8
+
+        return blockers;
+    }
+
+    [[nodiscard]] BitBoard pieceAttacks(const uint8_t &position) const {
+        const int8_t piece = this->pieceOn[position];
+        if (piece < 0) return 0ULL;
+
+        switch (piece % 6) {
+            case PAWN:
+                return piece < 6 ? preComputedMoves.whitePawn[position] : preComputedMoves.blackPawn[position];
+            case KNIGHT:
+                return preComputedMoves.knight[position];
+            case BISHOP:
+                return preComputedMoves.getBishopAttacks(position, this->occupancyAll);
+            case ROOK:
+                return preComputedMoves.getRookAttacks(position, this->occupancyAll);
+            case QUEEN:
+                return preComputedMoves.getQueenAttacks(position, this->occupancyAll);
+            default:
+                return preComputedMoves.king[position];
         }
     }
 
-    void clearCastleByCapture(const PieceColor &capturedColor, const uint8_t &position) {
-        if (capturedColor == WHITE) {
-            if (position == 0) this->castle &= ~2;
-            if (position == 7) this->castle &= ~1;
-        } else {
-            if (position == 56) this->castle &= ~8;
-            if (position == 63) this->castle &= ~4;
+    /**
+     * A changed square alters the attacks of the piece standing there and of every slider
+     * whose rays reached it. The nearest changed square on a ray was already visible before
+     * the change, so the old attack sets are enough to find the affected sliders
+     */
+    void refreshAttacks() const {
+        const BitBoard sliders = this->pieces[WHITE][BISHOP] | this->pieces[BLACK][BISHOP] |
+                                 this->pieces[WHITE][ROOK] | this->pieces[BLACK][ROOK] |
+                                 this->pieces[WHITE][QUEEN] | this->pieces[BLACK][QUEEN];
+
+        BitBoard affected = this->attacksDirty;
+        for (BitBoard temp = sliders & ~affected; temp; Bitboards::pop_lsb(temp)) {
+            const auto square = Bitboards::lsb_index(temp);
+            if (this->attacksFrom[square] & this->attacksDirty) affected |= Bitboards::bit(square);
+        }
+
+        for (; affected; Bitboards::pop_lsb(affected)) {
+            const auto square = static_cast<uint8_t>(Bitboards::lsb_index(affected));
+            this->attacksFrom[square] = this->pieceAttacks(square);
+        }
+        this->attacksDirty = 0;
+
+        for (const PieceColor color: {WHITE, BLACK}) {
+            BitBoard attacks = 0;
+            for (BitBoard temp = this->occupancy[color]; temp; Bitboards::pop_lsb(temp)) {
+                attacks |= this->attacksFrom[Bitboards::lsb_index(temp)];
+            }
+            this->attackedBy[color] = attacks;
         }
     }
+
+    static constexpr int CASTLE_RIGHTS_MASK[64] = {
+        13, 15, 15, 15, 12, 15, 15, 14,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        7, 15, 15, 15, 3, 15, 15, 11
+    };
 };
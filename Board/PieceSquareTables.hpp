@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Material values and piece-square tables shared by the running sums in Board, Evaluation
+ * and the static exchange evaluation.
+ * Tables are written with row 8 first, so white squares are mirrored with ^ 56.
+ */
+namespace PieceSquareTables {
+    // indexed by PieceType, the king value only matters for exchanges and is left out of the material sums,
+    // EMPTY is worth nothing
+    constexpr int VALUE[7] = {100, 320, 330, 500, 900, 20000, 0};
+
+    constexpr short PAWN[64] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        10, 10, 20, 30, 30, 20, 10, 10,
+        5, 5, 10, 25, 25, 10, 5, 5,
+        0, 0, 0, 20, 20, 0, 0, 0,
+        5, -5, -10, 0, 0, -10, -5, 5,
+        5, 10, 10, -20, -20, 10, 10, 5,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    constexpr short KNIGHT[64] = {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20, 0, 5, 5, 0, -20, -40,
+        -30, 5, 10, 15, 15, 10, 5, -30,
+        -30, 0, 15, 20, 20, 15, 0, -30,
+        -30, 5, 15, 20, 20, 15, 5, -30,
+        -30, 0, 10, 15, 15, 10, 0, -30,
+        -40, -20, 0, 0, 0, 0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    };
+
+    constexpr short BISHOP[64] = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10, 5, 0, 0, 0, 0, 5, -10,
+        -10, 10, 10, 10, 10, 10, 10, -10,
+        -10, 0, 10, 10, 10, 10, 0, -10,
+        -10, 5, 5, 10, 10, 5, 5, -10,
+        -10, 0, 5, 10, 10, 5, 0, -10,
+        -10, 0, 0, 0, 0, 0, 0, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    };
+
+    constexpr short ROOK[64] = {
+        0, 0, 0, 5, 5, 0, 0, 0,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        5, 10, 10, 10, 10, 10, 10, 5,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    constexpr short QUEEN[64] = {
+        -20, -10, -10, -5, -5, -10, -10, -20,
+        -10, 0, 0, 0, 0, 5, 0, -10,
+        -10, 0, 5, 5, 5, 5, 0, -10,
+        -5, 0, 5, 5, 5, 5, 0, -5,
+        0, 0, 5, 5, 5, 5, 0, -5,
+        -10, 5, 5, 5, 5, 5, 0, -10,
+        -10, 0, 5, 0, 0, 0, 0, -10,
+        -20, -10, -10, -5, -5, -10, -10, -20
+    };
+
+    constexpr short KING[64] = {
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+        20, 20, 0, 0, 0, 0, 20, 20,
+        20, 30, 10, 0, 0, 10, 30, 20
+    };
+
+    constexpr const short *TABLES[6] = {PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING};
+
+    struct Scores {
+        // [color][piece type][square], positive for white
+        int material[2][6]{};
+        int square[2][6][64]{};
+    };
+
+    constexpr Scores generate() {
+        Scores scores{};
+        for (int type = 0; type < 6; type++) {
+            const int value = type == 5 ? 0 : VALUE[type];
+            scores.material[0][type] = value;
+            scores.material[1][type] = -value;
+
+            for (int position = 0; position < 64; position++) {
+                scores.square[0][type][position] = TABLES[type][position ^ 56];
+                scores.square[1][type][position] = -TABLES[type][position];
+            }
+        }
+        return scores;
+    }
+
+    inline constexpr Scores SCORES = generate();
+}
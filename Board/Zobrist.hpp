@@ -11,23 +11,24 @@ public:
     static constexpr int PIECE_INDEX = COLORS * PIECE_TYPES;
     static constexpr int SQUARES = 64;
 
-    static Zobrist& instance() {
-        static auto instance = [] {
-            return Zobrist();
-        }();
+    /**
+     * Keys generated by the compiler into one cache-aligned global, never copied
+     */
+    static const Zobrist &instance();
 
-        return instance;
-    }
-
-    explicit Zobrist(const BitBoard seed = 0x9e3779b97f4a7c15ULL) {
+    constexpr explicit Zobrist(const BitBoard seed = 0x9e3779b97f4a7c15ULL) {
         uint64_t s = seed;
         for (auto &p: pieceRnd)
-            for (unsigned long long &sq: p)
+            for (auto &sq: p)
                 sq = splitmix64_seeded(s);
 
-        for (unsigned long long &i: castlingRnd) i = splitmix64_seeded(s);
-        for (unsigned long long &f: epFileRnd) f = splitmix64_seeded(s);
+        for (auto &i: castlingRnd) i = splitmix64_seeded(s);
+        for (auto &f: epFileRnd) f = splitmix64_seeded(s);
         sideRnd = splitmix64_seeded(s);
+
+        for (auto &p: materialRnd)
+            for (auto &count: p)
+                count = splitmix64_seeded(s);
     }
 
     [[nodiscard]] BitBoard computeKeyFromArrays(
@@ -76,17 +77,52 @@ public:
         );
     }
 
+    /**
+     * Pawns of both colors only, pawn structure caches are keyed by it
+     */
+    template<typename BoardT>
+    BitBoard computePawnKey(const BoardT &board) const {
+        uint64_t key = 0ULL;
+
+        for (int color = 0; color < COLORS; ++color) {
+            BitBoard bb = static_cast<BitBoard>(board.pieces[color][0]);
+            while (bb) key ^= pieceRnd[pieceIndexFrom(color, 0)][pop_lsb(bb)];
+        }
+
+        return key;
+    }
+
+    /**
+     * Piece counts only: the n-th piece of a kind contributes materialRnd[piece][n]
+     */
+    template<typename BoardT>
+    BitBoard computeMaterialKey(const BoardT &board) const {
+        uint64_t key = 0ULL;
+
+        for (int color = 0; color < COLORS; ++color) {
+            for (int pt = 0; pt < PIECE_TYPES; ++pt) {
+                const int count = __builtin_popcountll(static_cast<BitBoard>(board.pieces[color][pt]));
+                for (int n = 1; n <= count; ++n) key ^= materialRnd[pieceIndexFrom(color, pt)][n];
+            }
+        }
+
+        return key;
+    }
+
     static constexpr int pieceIndexFrom(const int color, const int pieceType) {
         return color * PIECE_TYPES + pieceType;
     }
 
     BitBoard pieceRnd[PIECE_INDEX][SQUARES]{};
-
-private:
+    // indexed by the 4 bit castle rights mask
     BitBoard castlingRnd[16]{};
     BitBoard epFileRnd[8]{};
+    // present when black is to move
     BitBoard sideRnd{};
+    // [piece][count], a legal position has at most 10 pieces of a kind
+    BitBoard materialRnd[PIECE_INDEX][16]{};
 
+private:
 
     static int pop_lsb(BitBoard &bb) {
         const int idx = __builtin_ctzll(bb);
@@ -94,10 +130,16 @@ private:
         return idx;
     }
 
-    static uint64_t splitmix64_seeded(uint64_t &x) {
+    static constexpr uint64_t splitmix64_seeded(uint64_t &x) {
         uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
         z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
         z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
         return z ^ (z >> 31);
     }
 };
+
+alignas(64) inline constexpr Zobrist zobristKeys{};
+
+inline const Zobrist &Zobrist::instance() {
+    return zobristKeys;
+}
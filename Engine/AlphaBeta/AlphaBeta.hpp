@@ -1,67 +1,107 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "../../Board/Board.hpp"
 #include "../Evaluation/Evaluation.hpp"
-#include "../../MoveGenerator/PseudoLegalMovesGenerator/PseudoLegalMovesGenerator.hpp"
+#include "../../MoveGenerator/MovePicker/MovePicker.hpp"
 #include "../../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+#include "../../MoveGenerator/StaticExchange/StaticExchange.hpp"
 #include "../TranspositionTable/TranspositionTable.hpp"
+#include "../Utils/KeyHistory.hpp"
+#include "../Utils/SearchLimits.hpp"
+#include "../Utils/SearchStats.hpp"
 
 constexpr int MAX_DEPTH = 128;
 
 
 inline thread_local UndoInfo undoStack[MAX_DEPTH];
+inline thread_local Move::Move killerMoves[MAX_DEPTH][2];
+// butterfly history [side][from][to], quiet moves causing cutoffs gain, the ones searched before them lose
+inline thread_local int butterflyHistory[2][64][64];
 
 class AlphaBeta {
 public:
     static int search(
         Board &board,
         TranspositionTable &table,
+        SearchLimits &limits,
+        const int depth,
+        const int alpha,
+        const int beta,
+        const int ply
+    ) {
+        if (board.side == WHITE) return search<WHITE>(board, table, limits, depth, alpha, beta, ply);
+        return search<BLACK>(board, table, limits, depth, alpha, beta, ply);
+    }
+
+    /**
+     * Side to move is a template parameter, children are searched by the opponent's instantiation
+     * @tparam Us side to move, has to be equal to board.side
+     */
+    template<PieceColor Us>
+    static int search(
+        Board &board,
+        TranspositionTable &table,
+        SearchLimits &limits,
         const int depth,
         int alpha,
         const int beta,
         const int ply
     ) {
+        constexpr PieceColor them = ColorTraits<Us>::them;
+
+        SearchStats::countNode(limits);
+        if (limits.stopped()) return 0;
+
+        keyHistory.set(ply, board.zobrist);
+        if (ply > 0 && isDraw(board, ply)) {
+            return Evaluation::DRAW;
+        }
+
         const auto alpha0 = alpha;
-        const auto us = board.side;
 
         if (depth == 0) {
-            return Evaluation::evaluate(board);
+            return quiesce<Us>(board, limits, alpha, beta, ply);
         }
 
-        if (const auto pr = table.probe(board.zobrist, depth, ply, alpha, beta); pr.hit) {
+        const auto pr = table.probe(board.zobrist, depth, ply, alpha, beta);
+        if (pr.hit) {
             if (pr.flag == TTFlag::EXACT) return pr.score;
             if (pr.flag == TTFlag::LOWER && pr.score >= beta) return pr.score;
             if (pr.flag == TTFlag::UPPER && pr.score <= alpha) return pr.score;
         }
 
-        const auto moveList = PseudoLegalMovesGenerator::generatePseudoLegalMoves(
-            board
-        );
-
-        if (moveList.m.empty()) {
-            if (MoveExecutor::isCheck(board, us)) {
-                return  -Evaluation::MATE - ply;
-            }
-            return 0;
-        }
+        MovePicker<Us> picker(board, pr.move, killerMoves[ply], butterflyHistory[Us]);
 
         Move::Move bestMove = 0;
+        Move::Move tried[Move::MAX_MOVES];
+        int triedCount = 0;
+
+        for (Move::Move move; (move = picker.next());) {
 
-        bool foundLegalMoves = false;
-        for (const auto &move: moveList.m) {
             UndoInfo &undo = undoStack[ply];
-            MoveExecutor::makeMove(board, move, undo);
+            MoveExecutor::makeMove<Us>(board, move, undo);
 
-            if (MoveExecutor::isCheck(board, us)) {
-                MoveExecutor::unmakeMove(board, move, undo);
-                continue;
+            // principal variation search: the first move gets the full window, the rest only
+            // have to be proven worse with a null window and are searched again if they are not
+            int score;
+            if (!triedCount) {
+                score = -search<them>(board, table, limits, depth - 1, -beta, -alpha, ply + 1);
+            } else {
+                score = -search<them>(board, table, limits, depth - 1, -alpha - 1, -alpha, ply + 1);
+                if (score > alpha && score < beta && !limits.stopped()) {
+                    score = -search<them>(board, table, limits, depth - 1, -beta, -alpha, ply + 1);
+                }
             }
+            MoveExecutor::unmakeMove<Us>(board, move, undo);
 
-            const auto score = -search(board, table, depth - 1, -beta, -alpha, ply + 1);
-            foundLegalMoves = true;
-            MoveExecutor::unmakeMove(board, move, undo);
+            // the score of an aborted subtree is meaningless, nothing is stored
+            if (limits.stopped()) return 0;
 
             if (score >= beta) {
+                updateQuietStats<Us>(board, move, depth, ply, tried, triedCount);
                 table.store(board.zobrist, depth, beta, TTFlag::LOWER, move, ply);
                 return beta;
             }
@@ -69,14 +109,14 @@ public:
                 alpha = score;
                 bestMove = move;
             }
+            tried[triedCount++] = move;
         }
 
-
-        if (!foundLegalMoves) {
-            if (MoveExecutor::isCheck(board, us)) {
+        if (!triedCount) {
+            if (picker.inCheck()) {
                 return -Evaluation::MATE - ply;
             }
-            return 0;
+            return Evaluation::DRAW;
         }
 
         TTFlag flag;
@@ -89,4 +129,159 @@ public:
         table.store(board.zobrist, depth, alpha, flag, bestMove, ply);
         return alpha;
     }
+
+    /**
+     * Captures only search below the horizon. The side to move may stand pat on the static
+     * evaluation, captures losing material by SEE or unable to lift the score close to alpha
+     * are skipped. In check every evasion is searched, there is no stand pat.
+     * @tparam Us side to move, has to be equal to board.side
+     */
+    template<PieceColor Us>
+    static int quiesce(Board &board, SearchLimits &limits, int alpha, const int beta, const int ply) {
+        constexpr PieceColor them = ColorTraits<Us>::them;
+
+        if (ply >= MAX_DEPTH - 1) return Evaluation::evaluate(board);
+
+        const auto info = LegalMovesGenerator::computeCheckInfo<Us>(board);
+        const bool inCheck = info.checkers != 0;
+        int standPat = Evaluation::NEG_INF;
+
+        Move::MoveList moves;
+        if (inCheck) {
+            LegalMovesGenerator::generate<Us, LegalMovesGenerator::GenType::ALL>(board, info, moves);
+            if (moves.empty()) return -Evaluation::MATE - ply;
+
+            for (int i = 0; i < moves.size(); i++) {
+                moves.score[i] = LegalMovesGenerator::mvvLva(board, moves[i]);
+            }
+        } else {
+            standPat = Evaluation::evaluate(board);
+            if (standPat >= beta) return beta;
+            if (standPat > alpha) alpha = standPat;
+
+            LegalMovesGenerator::generateTactical<Us>(board, info, moves);
+        }
+
+        for (int i = 0; i < moves.size(); i++) {
+            const auto move = pickBest(moves, i);
+
+            if (!inCheck) {
+                if (Move::moveType(move) != Move::MoveType::MT_PROMOTION &&
+                    standPat + capturedValue(board, move) + DELTA_MARGIN <= alpha) {
+                    continue;
+                }
+                if (!StaticExchange::isAtLeast(board, move, 0)) continue;
+            }
+
+            SearchStats::countNode(limits);
+
+            UndoInfo &undo = undoStack[ply];
+            MoveExecutor::makeMove<Us>(board, move, undo);
+            const auto score = -quiesce<them>(board, limits, -beta, -alpha, ply + 1);
+            MoveExecutor::unmakeMove<Us>(board, move, undo);
+
+            if (limits.stopped()) return 0;
+
+            if (score >= beta) return beta;
+            if (score > alpha) alpha = score;
+        }
+
+        return alpha;
+    }
+
+    /**
+     * Fifty move rule or a repetition of a position from the game or the search path.
+     * The key of the node has to be recorded at ply already. Checkmate delivered
+     * with the hundredth half move still counts as a loss.
+     */
+    static bool isDraw(const Board &board, const int ply) {
+        if (board.halfMove >= 100) {
+            return !board.isCheck() || !LegalMovesGenerator::generateLegalMoves(board).empty();
+        }
+        return keyHistory.isRepetition(ply, board.halfMove);
+    }
+
+    /**
+     * Killer and history update for a quiet move which caused a beta cutoff
+     * @param tried moves searched before it at this node, their quiets are penalized
+     */
+    template<PieceColor Us>
+    static void updateQuietStats(
+        const Board &board,
+        const Move::Move &move,
+        const int depth,
+        const int ply,
+        const Move::Move *tried,
+        const int triedCount
+    ) {
+        if (LegalMovesGenerator::isTactical(board, move)) return;
+
+        storeKiller(board, move, ply);
+
+        const int bonus = std::min(depth * depth, HISTORY_BONUS_MAX);
+        updateHistory(butterflyHistory[Us][Move::moveFrom(move)][Move::moveTo(move)], bonus);
+
+        for (int i = 0; i < triedCount; i++) {
+            if (LegalMovesGenerator::isTactical(board, tried[i])) continue;
+            updateHistory(butterflyHistory[Us][Move::moveFrom(tried[i])][Move::moveTo(tried[i])], -bonus);
+        }
+    }
+
+    /**
+     * Remember a quiet move which caused a beta cutoff at this ply
+     */
+    static void storeKiller(const Board &board, const Move::Move &move, const int ply) {
+        if (LegalMovesGenerator::isTactical(board, move)) return;
+
+        Move::Move *killers = killerMoves[ply];
+        if (killers[0] != move) {
+            killers[1] = killers[0];
+            killers[0] = move;
+        }
+    }
+
+private:
+    // positional swing a capture may bring on top of the captured material
+    static constexpr int DELTA_MARGIN = 200;
+    // history entries stay within +-HISTORY_MAX
+    static constexpr int HISTORY_MAX = 16384;
+    static constexpr int HISTORY_BONUS_MAX = 1200;
+
+    /**
+     * Moves the entry towards the bound of the bonus sign, the closer it is the smaller the step
+     */
+    static void updateHistory(int &entry, const int bonus) {
+        entry += bonus - entry * std::abs(bonus) / HISTORY_MAX;
+    }
+
+    /**
+     * Selection sort step: swap the best scored move from index on to index and return it
+     */
+    static Move::Move pickBest(Move::MoveList &moves, const int index) {
+        int best = index;
+        for (int i = index + 1; i < moves.size(); i++) {
+            if (moves.score[i] > moves.score[best]) best = i;
+        }
+
+        std::swap(moves[index], moves[best]);
+        std::swap(moves.score[index], moves.score[best]);
+
+        return moves[index];
+    }
+
+    static int capturedValue(const Board &board, const Move::Move &move) {
+        if (Move::moveType(move) == Move::MoveType::MT_ENPASSANT) return PieceSquareTables::VALUE[PieceType::PAWN];
+
+        const auto target = board.pieceOn[Move::moveTo(move)];
+        return target >= 0 ? PieceSquareTables::VALUE[target % 6] : 0;
+    }
+
+public:
+    static void clearKillers() {
+        std::memset(killerMoves, 0, sizeof(killerMoves));
+    }
+
+    static void clearHistory() {
+        std::memset(butterflyHistory, 0, sizeof(butterflyHistory));
+    }
 };
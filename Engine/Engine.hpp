@@ -1,15 +1,22 @@
 #pragma once
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "../Board/Board.hpp"
 #include "../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+#include "../MoveGenerator/LegalMovesGenerator/LegalMovesGenerator.hpp"
 #include "AlphaBeta/AlphaBeta.hpp"
 #include "Evaluation/Evaluation.hpp"
 #include "PvSplit/PvSplit.hpp"
 #include "ThreadPool/ThreadPool.hpp"
 #include "TranspositionTable/TranspositionTable.hpp"
 #include "../Board/Zobrist.hpp"
+#include "Utils/KeyHistory.hpp"
 #include "Utils/SearchConfig.hpp"
+#include "Utils/SearchLimits.hpp"
+#include "Utils/SearchStats.hpp"
 
 struct RootResult {
     int score;
@@ -19,44 +26,162 @@ struct RootResult {
 
 class Engine {
 public:
+    // half width of the first aspiration window, doubled after every fail
+    static constexpr int ASPIRATION_WINDOW = 25;
+    static constexpr int ASPIRATION_MIN_DEPTH = 4;
+    // wider windows are not worth another re-search, the failing bound is opened instead
+    static constexpr int ASPIRATION_MAX_WINDOW = 1000;
+
+    /**
+     * Iterative deepening up to config.maxDepth. Every iteration starts with the best move
+     * of the previous one and searches in an aspiration window around its score.
+     * When a limit stops the search the result of the last completed iteration is returned,
+     * the first legal move if there is none.
+     * @param gameKeys keys of the positions played before this one, oldest first, for repetition detection
+     */
     static RootResult run(
         Board &board,
         const SearchConfig &config,
-        TranspositionTable &table
+        TranspositionTable &table,
+        const std::vector<BitBoard> &gameKeys = {}
     ) {
+        SearchLimits limits;
+        return run(board, config, table, limits, gameKeys);
+    }
+
+    /**
+     * @param limits state of this search owned by the caller, which may stop() it from another thread
+     * and read its node count. Every search needs its own instance
+     */
+    static RootResult run(
+        Board &board,
+        const SearchConfig &config,
+        TranspositionTable &table,
+        SearchLimits &limits,
+        const std::vector<BitBoard> &gameKeys = {}
+    ) {
+        limits.start(config);
         ThreadPool pool(config.threads);
         RootResult result{0, 0};
 
-        const auto moveList = PseudoLegalMovesGenerator::generatePseudoLegalMoves(board);
+        AlphaBeta::clearKillers();
+        AlphaBeta::clearHistory();
+        keyHistory.reset(gameKeys, board.zobrist);
+        table.newSearch();
 
-        int alpha = Evaluation::NEG_INF;
-        constexpr int beta = Evaluation::INF;
-        const auto us = board.side;
+        auto rootMoves = LegalMovesGenerator::generateLegalMoves(board);
+        if (rootMoves.empty()) {
+            result.score = board.isCheck() ? -Evaluation::MATE : Evaluation::DRAW;
+            return result;
+        }
 
-        for (const auto &move: moveList.m) {
-            UndoInfo &undo = undoStack[0];
-            MoveExecutor::makeMove(board, move,undo);
-            if (MoveExecutor::isCheck(board, us)) {
-                MoveExecutor::unmakeMove(board, move,undo);
-                continue;
+        // best move of an earlier search of this position
+        moveToFront(rootMoves, table.probe(board.zobrist, 0, 0, Evaluation::NEG_INF, Evaluation::INF).move);
+        result.bestMove = rootMoves[0];
+
+        for (int depth = 1; depth <= config.maxDepth; depth++) {
+            int delta = ASPIRATION_WINDOW;
+            int alpha = Evaluation::NEG_INF;
+            int beta = Evaluation::INF;
+
+            if (depth >= ASPIRATION_MIN_DEPTH && std::abs(result.score) < Evaluation::MATE - 1000) {
+                alpha = result.score - delta;
+                beta = result.score + delta;
             }
 
-            const auto score = -PvSplit::searchPvSplit(pool, config, board, table,  alpha, beta, config.maxDepth, 1);
-            // std::cout << score << std::endl;
-            MoveExecutor::unmakeMove(board, move,undo);
+            RootResult iteration{0, 0};
+            while (true) {
+                iteration = searchRoot(pool, config, board, table, limits, rootMoves, alpha, beta, depth);
+
+                if (limits.stopped()) break;
+                if (iteration.score > alpha && iteration.score < beta) break;
+
+                delta *= 2;
+                if (iteration.score <= alpha) {
+                    alpha = delta > ASPIRATION_MAX_WINDOW
+                                ? Evaluation::NEG_INF
+                                : std::max(iteration.score - delta, Evaluation::NEG_INF);
+                } else {
+                    // the move refuting the window goes first in the re-search
+                    moveToFront(rootMoves, iteration.bestMove);
+                    beta = delta > ASPIRATION_MAX_WINDOW
+                               ? Evaluation::INF
+                               : std::min(iteration.score + delta, Evaluation::INF);
+                }
+            }
+
+            if (limits.stopped()) break;
+
+            result = iteration;
+            moveToFront(rootMoves, result.bestMove);
+            table.store(board.zobrist, depth, result.score, TTFlag::EXACT, result.bestMove, 0);
+
+            SearchStats::flush(limits);
+            if (config.onIteration) config.onIteration({depth, result.score, result.bestMove});
+
+            if (limits.softExpired()) break;
+        }
+
+        SearchStats::flush(limits);
+        return result;
+    }
+
+private:
+    /**
+     * One iteration over the root moves in their current order
+     * @return best score and move, the score is a bound when outside (alpha, beta)
+     */
+    static RootResult searchRoot(
+        ThreadPool &pool,
+        const SearchConfig &config,
+        Board &board,
+        TranspositionTable &table,
+        SearchLimits &limits,
+        const Move::MoveList &rootMoves,
+        int alpha,
+        const int beta,
+        const int depth
+    ) {
+        RootResult best{Evaluation::NEG_INF, rootMoves[0]};
+
+        for (int i = 0; i < rootMoves.size(); i++) {
+            const auto move = rootMoves[i];
+            UndoInfo &undo = undoStack[0];
+            MoveExecutor::makeMove(board, move, undo);
 
-            if (score > beta) {
-                return {beta, move};
+            // later root moves are scouted with a null window, splitting still applies below them
+            int score;
+            if (i == 0) {
+                score = -PvSplit::searchPvSplit(pool, config, board, table, limits, -beta, -alpha, depth - 1, 1);
+            } else {
+                score = -PvSplit::searchPvSplit(pool, config, board, table, limits, -alpha - 1, -alpha, depth - 1, 1);
+                if (score > alpha && score < beta && !limits.stopped()) {
+                    score = -PvSplit::searchPvSplit(pool, config, board, table, limits, -beta, -alpha, depth - 1, 1);
+                }
             }
+            MoveExecutor::unmakeMove(board, move, undo);
+
+            if (limits.stopped()) break;
 
+            if (score > best.score) {
+                best.score = score;
+                best.bestMove = move;
+            }
             if (score > alpha) {
                 alpha = score;
-                result.score = score;
-                result.bestMove = move;
+                if (alpha >= beta) break;
             }
-
         }
 
-        return result;
+        return best;
+    }
+
+    static void moveToFront(Move::MoveList &moves, const Move::Move &move) {
+        for (int i = 0; i < moves.size(); i++) {
+            if (moves[i] == move) {
+                std::rotate(moves.m, moves.m + i, moves.m + i + 1);
+                return;
+            }
+        }
     }
 };
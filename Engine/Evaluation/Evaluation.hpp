@@ -1,83 +1,28 @@
 #pragma once
+#include <stdexcept>
+
 #include "../../Board/Board.hpp"
+#include "../../Board/PieceSquareTables.hpp"
 
 class Evaluation {
 public:
     static constexpr int MATE = 320000;
     static constexpr int INF = 1000000000;
     static constexpr int NEG_INF = -INF;
+    static constexpr int DRAW = 0;
 
-    static constexpr int VALUE_PAWN = 100, VALUE_KNIGHT = 320, VALUE_BISHOP = 330, VALUE_ROOK = 500, VALUE_QUEEN = 900,
-            VALUE_KING = 20000;
-
-    static constexpr short PST_PAWN[64] = {
-        0, 0, 0, 0, 0, 0, 0, 0,
-        50, 50, 50, 50, 50, 50, 50, 50,
-        10, 10, 20, 30, 30, 20, 10, 10,
-        5, 5, 10, 25, 25, 10, 5, 5,
-        0, 0, 0, 20, 20, 0, 0, 0,
-        5, -5, -10, 0, 0, -10, -5, 5,
-        5, 10, 10, -20, -20, 10, 10, 5,
-        0, 0, 0, 0, 0, 0, 0, 0
-    };
-
-    static constexpr short PST_KNIGHT[64] = {
-        -50, -40, -30, -30, -30, -30, -40, -50,
-        -40, -20, 0, 5, 5, 0, -20, -40,
-        -30, 5, 10, 15, 15, 10, 5, -30,
-        -30, 0, 15, 20, 20, 15, 0, -30,
-        -30, 5, 15, 20, 20, 15, 5, -30,
-        -30, 0, 10, 15, 15, 10, 0, -30,
-        -40, -20, 0, 0, 0, 0, -20, -40,
-        -50, -40, -30, -30, -30, -30, -40, -50
-    };
-
-    static constexpr short PST_BISHOP[64] = {
-        -20, -10, -10, -10, -10, -10, -10, -20,
-        -10, 5, 0, 0, 0, 0, 5, -10,
-        -10, 10, 10, 10, 10, 10, 10, -10,
-        -10, 0, 10, 10, 10, 10, 0, -10,
-        -10, 5, 5, 10, 10, 5, 5, -10,
-        -10, 0, 5, 10, 10, 5, 0, -10,
-        -10, 0, 0, 0, 0, 0, 0, -10,
-        -20, -10, -10, -10, -10, -10, -10, -20
-    };
-
-    static constexpr short PST_ROOK[64] = {
-        0, 0, 0, 5, 5, 0, 0, 0,
-        -5, 0, 0, 0, 0, 0, 0, -5,
-        -5, 0, 0, 0, 0, 0, 0, -5,
-        -5, 0, 0, 0, 0, 0, 0, -5,
-        -5, 0, 0, 0, 0, 0, 0, -5,
-        -5, 0, 0, 0, 0, 0, 0, -5,
-        5, 10, 10, 10, 10, 10, 10, 5,
-        0, 0, 0, 0, 0, 0, 0, 0
-    };
-
-    static constexpr short PST_QUEEN[64] = {
-        -20, -10, -10, -5, -5, -10, -10, -20,
-        -10, 0, 0, 0, 0, 5, 0, -10,
-        -10, 0, 5, 5, 5, 5, 0, -10,
-        -5, 0, 5, 5, 5, 5, 0, -5,
-        0, 0, 5, 5, 5, 5, 0, -5,
-        -10, 5, 5, 5, 5, 5, 0, -10,
-        -10, 0, 5, 0, 0, 0, 0, -10,
-        -20, -10, -10, -5, -5, -10, -10, -20
-    };
-
-    static constexpr short PST_KING[64] = {
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -20, -30, -30, -40, -40, -30, -30, -20,
-        -10, -20, -20, -20, -20, -20, -20, -10,
-        20, 20, 0, 0, 0, 0, 20, 20,
-        20, 30, 10, 0, 0, 10, 30, 20
-    };
+    static constexpr int VALUE_PAWN = PieceSquareTables::VALUE[PAWN], VALUE_KNIGHT = PieceSquareTables::VALUE[KNIGHT],
+            VALUE_BISHOP = PieceSquareTables::VALUE[BISHOP], VALUE_ROOK = PieceSquareTables::VALUE[ROOK],
+            VALUE_QUEEN = PieceSquareTables::VALUE[QUEEN], VALUE_KING = PieceSquareTables::VALUE[KING];
 
+    /**
+     * Material and piece-square sums are kept up to date by Board, the static eval is O(1)
+     */
     static int evaluate(const Board &board) {
-        const int result = getMaterialScore(board) + getPieceSquareTableScore(board);
+#if defined(VERIFY_EVALUATION)
+        verifyScores(board);
+#endif
+        const int result = board.materialScore + board.pstScore;
         if (board.side == PieceColor::WHITE) {
             return result;
         }
@@ -97,6 +42,17 @@ public:
         return score;
     }
 
+#if defined(VERIFY_EVALUATION)
+    /**
+     * Debug builds (-DVERIFY_EVALUATION=ON) compare the running sums with a full recomputation
+     */
+    static void verifyScores(const Board &board) {
+        if (board.materialScore != getMaterialScore(board) || board.pstScore != getPieceSquareTableScore(board)) {
+            throw std::logic_error("incremental material / PST sums differ from the full recomputation");
+        }
+    }
+#endif
+
 private:
     static int getPieceSquareValue(const short *pst, const uint8_t position, const PieceColor c) {
         return (c == PieceColor::WHITE) ? pst[position ^ 56] : pst[position];
@@ -143,24 +99,24 @@ private:
             }
         };
 
-        acc(PieceColor::WHITE, PieceType::PAWN, PST_PAWN);
-        acc(PieceColor::BLACK, PieceType::PAWN, PST_PAWN);
+        acc(PieceColor::WHITE, PieceType::PAWN, PieceSquareTables::PAWN);
+        acc(PieceColor::BLACK, PieceType::PAWN, PieceSquareTables::PAWN);
 
-        acc(PieceColor::WHITE, PieceType::KNIGHT, PST_KNIGHT);
-        acc(PieceColor::BLACK, PieceType::KNIGHT, PST_KNIGHT);
+        acc(PieceColor::WHITE, PieceType::KNIGHT, PieceSquareTables::KNIGHT);
+        acc(PieceColor::BLACK, PieceType::KNIGHT, PieceSquareTables::KNIGHT);
         //
-        acc(PieceColor::WHITE, PieceType::BISHOP, PST_BISHOP);
-        acc(PieceColor::BLACK, PieceType::BISHOP, PST_BISHOP);
+        acc(PieceColor::WHITE, PieceType::BISHOP, PieceSquareTables::BISHOP);
+        acc(PieceColor::BLACK, PieceType::BISHOP, PieceSquareTables::BISHOP);
         //
-        acc(PieceColor::WHITE, PieceType::ROOK, PST_ROOK);
-        acc(PieceColor::BLACK, PieceType::ROOK, PST_ROOK);
+        acc(PieceColor::WHITE, PieceType::ROOK, PieceSquareTables::ROOK);
+        acc(PieceColor::BLACK, PieceType::ROOK, PieceSquareTables::ROOK);
         //
-        acc(PieceColor::WHITE, PieceType::QUEEN, PST_QUEEN);
-        acc(PieceColor::BLACK, PieceType::QUEEN, PST_QUEEN);
+        acc(PieceColor::WHITE, PieceType::QUEEN, PieceSquareTables::QUEEN);
+        acc(PieceColor::BLACK, PieceType::QUEEN, PieceSquareTables::QUEEN);
 
         //
-        acc(PieceColor::WHITE, PieceType::KING, PST_KING);
-        acc(PieceColor::BLACK, PieceType::KING, PST_KING);
+        acc(PieceColor::WHITE, PieceType::KING, PieceSquareTables::KING);
+        acc(PieceColor::BLACK, PieceType::KING, PieceSquareTables::KING);
 
         return score;
     }
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "../AlphaBeta/AlphaBeta.hpp"
 #include "../ThreadPool/ThreadPool.hpp"
+#include "../Utils/KeyHistory.hpp"
 #include "../Utils/SplitPoint.hpp"
 #include "../Utils/SearchConfig.hpp"
+#include "../Utils/SearchLimits.hpp"
+#include "../Utils/SearchStats.hpp"
 #include "../TranspositionTable/TranspositionTable.hpp"
+#include "../../MoveGenerator/MovePicker/MovePicker.hpp"
 
 
 class PvSplit {
@@ -13,76 +18,109 @@ public:
         const SearchConfig &config,
         Board &board,
         TranspositionTable &table,
+        SearchLimits &limits,
+        const int alpha,
+        const int beta,
+        const int depth,
+        const int ply
+    ) {
+        if (board.side == WHITE) return searchPvSplit<WHITE>(pool, config, board, table, limits, alpha, beta, depth, ply);
+        return searchPvSplit<BLACK>(pool, config, board, table, limits, alpha, beta, depth, ply);
+    }
+
+    /**
+     * @tparam Us side to move, has to be equal to board.side
+     */
+    template<PieceColor Us>
+    static int searchPvSplit(
+        ThreadPool &pool,
+        const SearchConfig &config,
+        Board &board,
+        TranspositionTable &table,
+        SearchLimits &limits,
         int alpha,
         const int beta,
         const int depth,
         const int ply
     ) {
+        constexpr PieceColor them = ColorTraits<Us>::them;
+
+        SearchStats::countNode(limits);
+        if (limits.stopped()) return 0;
+
+        keyHistory.set(ply, board.zobrist);
+        if (ply > 0 && AlphaBeta::isDraw(board, ply)) {
+            return Evaluation::DRAW;
+        }
+
         if (depth == 0) {
-            return Evaluation::evaluate(board);
+            return AlphaBeta::quiesce<Us>(board, limits, alpha, beta, ply);
         }
 
-        const auto us = board.side;
         int best = Evaluation::NEG_INF;
         const int alpha0 = alpha;
         Move::Move bestMove = 0;
 
-        if (auto pr = table.probe(board.zobrist, depth, ply, alpha, beta); pr.hit) {
+        const auto pr = table.probe(board.zobrist, depth, ply, alpha, beta);
+        if (pr.hit) {
             if (pr.flag == TTFlag::EXACT) return pr.score;
             if (pr.flag == TTFlag::LOWER && pr.score >= beta) return pr.score;
             if (pr.flag == TTFlag::UPPER && pr.score <= alpha) return pr.score;
         }
 
-        const auto moveList = PseudoLegalMovesGenerator::generatePseudoLegalMoves(board);
-        if (moveList.m.empty()) {
-            if (MoveExecutor::isCheck(board, us)) {
+        // PV nodes rarely cut off and a split point needs every move up front,
+        // so the picker is drained into an ordered list here
+        MovePicker<Us> picker(board, pr.move, killerMoves[ply], butterflyHistory[Us]);
+        Move::MoveList moveList;
+        for (Move::Move move; (move = picker.next());) {
+            moveList.push(move);
+        }
+
+        if (moveList.empty()) {
+            if (picker.inCheck()) {
                 return  -Evaluation::MATE - ply;
             }
-            return 0;
+            return Evaluation::DRAW;
         }
 
-        const auto firstMove = moveList.m[0];
+        const auto firstMove = moveList[0];
         {
             UndoInfo &undo = undoStack[ply];
-            MoveExecutor::makeMove(board, firstMove, undo);
-
-            if (!MoveExecutor::isCheck(board, us)) {
-                const auto score = -searchPvSplit(pool, config, board, table, -beta, -alpha, depth - 1, ply + 1);
-                MoveExecutor::unmakeMove(board, firstMove, undo);
-
-                if (score > best) {
-                    best = score;
-                    bestMove = firstMove;
-                }
-                if (best > alpha) {
-                    alpha = score;
-                    if (alpha >= beta) {
-                        table.store(board.zobrist, depth, beta, TTFlag::LOWER, bestMove, ply);
-                        return alpha;
-                    }
+            MoveExecutor::makeMove<Us>(board, firstMove, undo);
+            const auto score = -searchPvSplit<them>(pool, config, board, table, limits, -beta, -alpha, depth - 1, ply + 1);
+            MoveExecutor::unmakeMove<Us>(board, firstMove, undo);
+            if (limits.stopped()) return 0;
+
+            if (score > best) {
+                best = score;
+                bestMove = firstMove;
+            }
+            if (best > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    AlphaBeta::updateQuietStats<Us>(board, bestMove, depth, ply, nullptr, 0);
+                    table.store(board.zobrist, depth, beta, TTFlag::LOWER, bestMove, ply);
+                    return alpha;
                 }
-            } else {
-                MoveExecutor::unmakeMove(board, firstMove, undo);
             }
         }
 
 
-        const auto canSplit = depth <= config.splitMinDepth && moveList.m.size() > config.splitMinDepth;
-        bool foundLegalMoves = false;
+        const auto canSplit = depth <= config.splitMinDepth && moveList.size() > config.splitMinDepth;
 
         if (!canSplit) {
-            for (int i = 1; i < moveList.m.size(); i++) {
-                const auto move = moveList.m[i];
+            for (int i = 1; i < moveList.size(); i++) {
+                const auto move = moveList[i];
                 UndoInfo &undo = undoStack[ply];
 
-                MoveExecutor::makeMove(board, move, undo);
-                if (MoveExecutor::isCheck(board, us)) {
-                    MoveExecutor::unmakeMove(board, move, undo);
-                    continue;
+                MoveExecutor::makeMove<Us>(board, move, undo);
+                auto sc = -AlphaBeta::search<them>(board, table, limits, depth - 1, -alpha - 1, -alpha, ply + 1);
+                if (sc > alpha && sc < beta && !limits.stopped()) {
+                    sc = -AlphaBeta::search<them>(board, table, limits, depth - 1, -beta, -alpha, ply + 1);
                 }
-                foundLegalMoves = true;
-                const auto sc = -AlphaBeta::search(board, table, depth - 1, -beta, -alpha, ply + 1);
-                MoveExecutor::unmakeMove(board, move, undo);
+                MoveExecutor::unmakeMove<Us>(board, move, undo);
+                if (limits.stopped()) return 0;
+
                 if (sc > best) {
                     best = sc;
                     bestMove = move;
@@ -90,20 +128,13 @@ public:
                 if (sc > alpha) {
                     alpha = sc;
                     if (alpha >= beta) {
+                        AlphaBeta::updateQuietStats<Us>(board, bestMove, depth, ply, moveList.m, i);
                         table.store(board.zobrist, depth, beta, TTFlag::LOWER, bestMove, ply);
                         return alpha;
                     }
                 }
             }
 
-            if (!foundLegalMoves) {
-                if (MoveExecutor::isCheck(board, us)) {
-                    return -Evaluation::MATE - ply;
-                }
-                return 0;
-            }
-
-
             TTFlag flag;
             if (alpha <= alpha0) {
                 flag = TTFlag::UPPER;
@@ -115,25 +146,25 @@ public:
             return alpha;
         }
 
-        SplitPoint sp{board, alpha, beta, depth, ply, true, moveList.m};
+        SplitPoint sp{board, keyHistory, alpha, beta, depth, ply, true, moveList};
         sp.nextIdx.store(1, std::memory_order_relaxed);
         sp.bestMove = bestMove;
         sp.bestScore.store(best, std::memory_order_relaxed);
 
 
-        const unsigned toSpawn = std::min<unsigned>(pool.size() - 1, (moveList.m.size() > 1 ? moveList.m.size() - 1 : 0));
+        const unsigned toSpawn = std::min<unsigned>(pool.size() - 1, (moveList.size() > 1 ? moveList.size() - 1 : 0));
         sp.active.store(static_cast<int>(toSpawn) + 1, std::memory_order_relaxed);
 
         std::mutex doneMutex;
         std::condition_variable doneCv;
 
         for (unsigned int i = 0; i < toSpawn; i++) {
-            pool.submit([&table, &doneMutex, ply, &sp, &doneCv]() {
-                workerConsumeSplitPoint(table, sp, ply, doneMutex, doneCv);
+            pool.submit([&table, &limits, &doneMutex, ply, &sp, &doneCv]() {
+                workerConsumeSplitPoint<Us>(table, limits, sp, ply, doneMutex, doneCv);
             });
         }
 
-        workerConsumeSplitPoint(table, sp, ply, doneMutex, doneCv);
+        workerConsumeSplitPoint<Us>(table, limits, sp, ply, doneMutex, doneCv);
 
         {
             std::unique_lock<std::mutex> lk(doneMutex);
@@ -142,6 +173,8 @@ public:
             });
         }
 
+        if (limits.stopped()) return 0;
+
         const int a = sp.alpha.load(std::memory_order_relaxed);
         const int bst = sp.bestScore.load(std::memory_order_relaxed);
         const int finalBest = std::max(a, bst);
@@ -163,35 +196,38 @@ public:
     }
 
 private:
+    template<PieceColor Us>
     static void workerConsumeSplitPoint(
         TranspositionTable &table,
+        SearchLimits &limits,
         SplitPoint &sp,
         const int ply,
         std::mutex &doneMutex,
         std::condition_variable &doneCv
     ) {
-        const auto us = sp.parent.side;
         Board child = sp.parent;
+        keyHistory.copyPrefix(sp.history, ply);
 
-        while (!sp.abort.load(std::memory_order_relaxed)) {
+        while (!sp.abort.load(std::memory_order_relaxed) && !limits.stopped()) {
             const int i = sp.nextIdx.fetch_add(1, std::memory_order_relaxed);
-            if (i >= static_cast<int>(sp.moves.size())) break;
+            if (i >= sp.moves.size()) break;
 
             const Move::Move move = sp.moves[i];
 
             UndoInfo undo{};
 
-            MoveExecutor::makeMove(child, move, undo);
-            if (MoveExecutor::isCheck(child, us)) {
-                MoveExecutor::unmakeMove(child, move, undo);
-                continue;
-            };
+            MoveExecutor::makeMove<Us>(child, move, undo);
 
             const int a = sp.alpha.load(std::memory_order_acquire);
             const int b = sp.beta;
 
-            const int sc = -AlphaBeta::search(child, table, sp.depth - 1, -b, -a, ply + 1);
-            MoveExecutor::unmakeMove(child, move, undo);
+            // null window around the shared alpha, the full window only when the move beats it
+            int sc = -AlphaBeta::search<ColorTraits<Us>::them>(child, table, limits, sp.depth - 1, -a - 1, -a, ply + 1);
+            if (sc > a && sc < b && !limits.stopped()) {
+                sc = -AlphaBeta::search<ColorTraits<Us>::them>(child, table, limits, sp.depth - 1, -b, -a, ply + 1);
+            }
+            MoveExecutor::unmakeMove<Us>(child, move, undo);
+            if (limits.stopped()) break;
 
             // CAS na α + best; cutoff na >= beta
             int prev = sp.alpha.load(std::memory_order_acquire);
@@ -205,12 +241,16 @@ private:
                     sp.bestMove = move;
                     if (sc >= sp.beta) {
                         sp.abort.store(true, std::memory_order_release);
+                        // killers and history of the thread which found the cutoff
+                        AlphaBeta::updateQuietStats<Us>(child, move, sp.depth, ply, nullptr, 0);
                     }
                     break;
                 }
             }
         }
 
+        SearchStats::flush(limits);
+
         // „ostatni gasi światło” – budzi czekającego
         if (sp.active.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             std::lock_guard<std::mutex> lk(doneMutex);
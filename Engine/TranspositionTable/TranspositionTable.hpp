@@ -77,12 +77,14 @@ public:
             const Entity d = decode(raw);
 
             if (d.key16 != key16) continue;
-            if (d.depth < depth_min) continue;
+
+            // too shallow for a cutoff, but the move is still good enough for ordering
+            r.move = d.move;
+            if (d.depth < depth_min) return r;
 
             r.hit = true;
             r.depth = d.depth;
             r.flag = static_cast<TTFlag>(d.flag);
-            r.move = d.move;
 
             const int s = static_cast<int>(static_cast<int16_t>(d.score16));
             r.score = Evaluation::fromTtScore(s, ply);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "../../Bitboard.h"
+
+/**
+ * Position keys of the game followed by the current search path, one slot per ply.
+ * The root sits right after the game keys, a node at ply p writes its key to root + p,
+ * so nothing has to be popped on the way back.
+ */
+class KeyHistory {
+public:
+    // older positions are behind an irreversible move or past the fifty move limit
+    static constexpr int MAX_GAME_KEYS = 256;
+    static constexpr int MAX_PLY = 256;
+
+    /**
+     * @param gameKeys keys of the positions played before the root, oldest first
+     * @param rootKey key of the root position
+     */
+    void reset(const std::vector<BitBoard> &gameKeys, const BitBoard &rootKey) {
+        const size_t first = gameKeys.size() > MAX_GAME_KEYS ? gameKeys.size() - MAX_GAME_KEYS : 0;
+
+        this->root = 0;
+        for (size_t i = first; i < gameKeys.size(); i++) {
+            this->keys[this->root++] = gameKeys[i];
+        }
+        this->keys[this->root] = rootKey;
+    }
+
+    void set(const int ply, const BitBoard &key) {
+        this->keys[this->root + ply] = key;
+    }
+
+    /**
+     * Only positions with the same side to move and no irreversible move in between can repeat,
+     * so the scan steps two plies at a time and stops halfMove plies back
+     * @return whether the position at ply occurred before on the game or search path
+     */
+    bool isRepetition(const int ply, const int halfMove) const {
+        const int current = this->root + ply;
+        const int oldest = std::max(0, current - halfMove);
+        const BitBoard key = this->keys[current];
+
+        for (int i = current - 4; i >= oldest; i -= 2) {
+            if (this->keys[i] == key) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Take over the game and the path up to ply, used by split point helpers
+     */
+    void copyPrefix(const KeyHistory &other, const int ply) {
+        if (&other == this) return;
+
+        this->root = other.root;
+        std::copy(other.keys, other.keys + other.root + ply + 1, this->keys);
+    }
+
+private:
+    BitBoard keys[MAX_GAME_KEYS + MAX_PLY]{};
+    int root = 0;
+};
+
+inline thread_local KeyHistory keyHistory;
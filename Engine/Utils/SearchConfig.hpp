@@ -1,8 +1,31 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+
+#include "../../MoveGenerator/Move/Move.hpp"
+
+/**
+ * Result of one completed iterative deepening iteration
+ */
+struct IterationInfo {
+    int depth;
+    int score;
+    Move::Move bestMove;
+};
+
 struct SearchConfig {
     int maxDepth = 12;
     unsigned threads = 4;
     int splitMinDepth = 4;
     int splitMinMoves = 2;
+
+    // 0 disables a limit. No depth is started after the soft time, the hard time
+    // and the node count abort the running one
+    int64_t softTimeMs = 0;
+    int64_t hardTimeMs = 0;
+    uint64_t maxNodes = 0;
+
+    // called by the searching thread after every completed depth
+    std::function<void(const IterationInfo &)> onIteration;
 };
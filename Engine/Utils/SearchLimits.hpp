@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "SearchConfig.hpp"
+
+/**
+ * Time, node and external stop limits of one search, shared by the threads working on it.
+ * The clock and the node total are looked at only when a thread publishes its node batch,
+ * the search itself reads a single flag.
+ */
+class SearchLimits {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr Clock::time_point NO_DEADLINE = Clock::time_point::max();
+
+    /**
+     * Called by the searching thread before any helper starts, the deadlines run from here.
+     * A stop requested earlier is kept, so it cannot be lost between creating and starting the search
+     */
+    void start(const SearchConfig &config) {
+        const auto now = Clock::now();
+        this->softDeadline = config.softTimeMs ? now + std::chrono::milliseconds(config.softTimeMs) : NO_DEADLINE;
+        this->hardDeadline = config.hardTimeMs ? now + std::chrono::milliseconds(config.hardTimeMs) : NO_DEADLINE;
+        this->nodeLimit = config.maxNodes;
+    }
+
+    /**
+     * Add a published node batch and check the limits against the new total
+     */
+    void addNodes(const uint64_t &count) {
+        const uint64_t total = this->totalNodes.fetch_add(count, std::memory_order_relaxed) + count;
+        if ((this->nodeLimit && total >= this->nodeLimit) || Clock::now() >= this->hardDeadline) {
+            this->stop();
+        }
+    }
+
+    /**
+     * @return nodes published by all threads of this search so far
+     */
+    [[nodiscard]] uint64_t nodes() const {
+        return this->totalNodes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Safe to call from any thread, the search unwinds and keeps the last completed iteration
+     */
+    void stop() {
+        this->stopFlag.store(true, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool stopped() const {
+        return this->stopFlag.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Checked between iterations, a new depth is not started after the soft deadline
+     */
+    [[nodiscard]] bool softExpired() const {
+        return Clock::now() >= this->softDeadline;
+    }
+
+private:
+    std::atomic<bool> stopFlag{false};
+    std::atomic<uint64_t> totalNodes{0};
+    // written by start() only, before the helpers are running
+    Clock::time_point softDeadline = NO_DEADLINE;
+    Clock::time_point hardDeadline = NO_DEADLINE;
+    uint64_t nodeLimit = 0;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include "SearchLimits.hpp"
+
+class SearchStats {
+public:
+    static constexpr uint64_t FLUSH_INTERVAL = 1024;
+
+    /**
+     * Count one visited node. Nodes are accumulated per thread and published
+     * to the search's counter in batches, so the hot path never touches a shared cache line.
+     */
+    static void countNode(SearchLimits &limits) {
+        if (++pendingNodes >= FLUSH_INTERVAL) {
+            flush(limits);
+        }
+    }
+
+    /**
+     * Publish the batch to the search, which checks its limits against the new total.
+     * Engine::run and the split point helpers flush before leaving the search
+     */
+    static void flush(SearchLimits &limits) {
+        if (pendingNodes) {
+            limits.addNodes(pendingNodes);
+            pendingNodes = 0;
+        }
+    }
+
+private:
+    static inline thread_local uint64_t pendingNodes = 0;
+};
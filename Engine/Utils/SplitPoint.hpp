@@ -4,6 +4,7 @@
 
 #include "../../Board/Board.hpp"
 #include "../../MoveGenerator/Move/Move.hpp"
+#include "KeyHistory.hpp"
 
 struct SplitPoint {
     std::atomic<int> alpha;
@@ -17,16 +18,18 @@ struct SplitPoint {
     const bool pvNode;
 
     const Board &parent;
+    // keys of the splitting thread up to ply, helpers copy them before searching
+    const KeyHistory &history;
 
-    std::vector<Move::Move> moves;
+    const Move::MoveList &moves;
     std::atomic<int> nextIdx{0};
     std::atomic<int> active{0};
     std::atomic<bool> abort{false};
 
-    SplitPoint(const Board &parent, const int alpha, const int beta, const int depth, const int ply,
-               const bool pvNode, const std::vector<Move::Move> &moves)
+    SplitPoint(const Board &parent, const KeyHistory &history, const int alpha, const int beta, const int depth, const int ply,
+               const bool pvNode, const Move::MoveList &moves)
         : alpha(alpha), beta(beta), bestScore(Evaluation::NEG_INF), bestMove(0),
-          depth(depth), ply(ply), pvNode(pvNode), parent(parent), moves(moves) {
+          depth(depth), ply(ply), pvNode(pvNode), parent(parent), history(history), moves(moves) {
         // std::cout << "SplitPoint::SplitPoint()" << std::endl;
     }
 };
@@ -0,0 +1,525 @@
+#pragma once
+#include "../../Bitboard.h"
+#include "../../Board/Board.hpp"
+#include "../PseudoLegalMovesGenerator/PseudoLegalMovesGenerator.hpp"
+
+class LegalMovesGenerator {
+public:
+    /**
+     * CAPTURES: captures, en passant, capture promotions and queen push promotions
+     * QUIETS: everything else (pushes, under-promotion pushes, castles)
+     */
+    enum class GenType {
+        ALL,
+        CAPTURES,
+        QUIETS
+    };
+
+    struct CheckInfo {
+        // enemy pieces giving check to our king
+        BitBoard checkers;
+        // our pieces pinned to our king, each one may only move along line[king][from]
+        BitBoard pinned;
+        // squares a non-king move has to land on (block or capture the checker)
+        BitBoard checkMask;
+        // squares attacked by the enemy with our king removed from the board
+        BitBoard kingDanger;
+    };
+
+    static CheckInfo computeCheckInfo(const Board &board, const PieceColor &us) {
+        if (us == PieceColor::WHITE) return computeCheckInfo<PieceColor::WHITE>(board);
+        return computeCheckInfo<PieceColor::BLACK>(board);
+    }
+
+    /**
+     * Compute checkers, pinned pieces and king danger squares for the side to move,
+     * checkers and pins come from the check state cached in the board
+     * @tparam Us side to move
+     * @param board position
+     * @return CheckInfo
+     */
+    template<PieceColor Us>
+    static CheckInfo computeCheckInfo(const Board &board) {
+        constexpr PieceColor them = ColorTraits<Us>::them;
+        const uint8_t kingPosition = board.kingSq[Us];
+        const BitBoard occupancyAll = board.occupancyAll;
+        const CheckState &state = board.getCheckState();
+
+        const BitBoard enemyDiagonal = board.pieces[them][PieceType::BISHOP] | board.pieces[them][PieceType::QUEEN];
+        const BitBoard enemyOrthogonal = board.pieces[them][PieceType::ROOK] | board.pieces[them][PieceType::QUEEN];
+
+        CheckInfo info{};
+        info.checkers = state.checkers;
+        info.pinned = state.blockersForKing[Us] & board.occupancy[Us];
+
+        if (!info.checkers) {
+            info.checkMask = ~0ULL;
+        } else if (!(info.checkers & (info.checkers - 1))) {
+            const auto checker = static_cast<uint8_t>(Bitboards::lsb_index(info.checkers));
+            info.checkMask = preComputedMoves.between[kingPosition][checker] | info.checkers;
+        } else {
+            info.checkMask = 0ULL;
+        }
+
+        if (board.trackAttacks) {
+            // the maps see the king as a blocker, squares behind it on a checking line are added back
+            info.kingDanger = board.getAttackedBy(them);
+            for (BitBoard sliders = info.checkers & (enemyDiagonal | enemyOrthogonal); sliders;
+                 Bitboards::pop_lsb(sliders)) {
+                const auto checker = static_cast<uint8_t>(Bitboards::lsb_index(sliders));
+                info.kingDanger |= preComputedMoves.line[kingPosition][checker] & ~Bitboards::bit(checker);
+            }
+        } else {
+            info.kingDanger = getAttackedFields<them>(board, occupancyAll & ~Bitboards::bit(kingPosition));
+        }
+
+        return info;
+    }
+
+    static Move::MoveList generateLegalMoves(const Board &board) {
+        Move::MoveList moves;
+
+        if (board.side == PieceColor::WHITE) {
+            generate<PieceColor::WHITE, GenType::ALL>(board, computeCheckInfo<PieceColor::WHITE>(board), moves);
+        } else {
+            generate<PieceColor::BLACK, GenType::ALL>(board, computeCheckInfo<PieceColor::BLACK>(board), moves);
+        }
+
+        return moves;
+    }
+
+    template<GenType Type>
+    static void generate(
+        const Board &board,
+        const CheckInfo &info,
+        Move::MoveList &moves,
+        const BitBoard &sources = ~0ULL
+    ) {
+        if (board.side == PieceColor::WHITE) generate<PieceColor::WHITE, Type>(board, info, moves, sources);
+        else generate<PieceColor::BLACK, Type>(board, info, moves, sources);
+    }
+
+    /**
+     * Append legal moves of the given type
+     * @tparam Us side to move
+     * @param board position
+     * @param info check info of the side to move
+     * @param moves output list
+     * @param sources only pieces standing on these squares are generated
+     */
+    template<PieceColor Us, GenType Type>
+    static void generate(
+        const Board &board,
+        const CheckInfo &info,
+        Move::MoveList &moves,
+        const BitBoard &sources = ~0ULL
+    ) {
+        // in double check only the king can move
+        if (info.checkMask) {
+            getSliderMoves<Us, Type, PieceType::QUEEN>(board, info, sources, moves);
+            getSliderMoves<Us, Type, PieceType::ROOK>(board, info, sources, moves);
+            getSliderMoves<Us, Type, PieceType::BISHOP>(board, info, sources, moves);
+            getKnightMoves<Us, Type>(board, info, sources, moves);
+            getPawnMoves<Us, Type>(board, info, sources, moves);
+        }
+
+        if (sources & Bitboards::bit(board.kingSq[Us])) {
+            getKingMoves<Us, Type>(board, info, moves);
+
+            if (Type != GenType::CAPTURES && !info.checkers) {
+                getCastles<Us>(board, info, moves);
+            }
+        }
+    }
+
+    static bool isLegal(const Board &board, const CheckInfo &info, const Move::Move &move) {
+        if (board.side == PieceColor::WHITE) return isLegal<PieceColor::WHITE>(board, info, move);
+        return isLegal<PieceColor::BLACK>(board, info, move);
+    }
+
+    /**
+     * Check whether a move coming from outside of the generator (TT, killers) is legal here
+     */
+    template<PieceColor Us>
+    static bool isLegal(const Board &board, const CheckInfo &info, const Move::Move &move) {
+        const auto from = Move::moveFrom(move);
+        const auto pieceCode = board.pieceOn[from];
+
+        if (move == 0 || pieceCode < 0 || pieceCode / 6 != Us) return false;
+
+        Move::MoveList moves;
+        generate<Us, GenType::ALL>(board, info, moves, Bitboards::bit(from));
+
+        for (const auto &candidate: moves) {
+            if (candidate == move) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Captures, capture promotions and queen promotions only, each scored with MVV-LVA
+     * so quiescence never pays for quiet move generation
+     * @tparam Us side to move
+     * @param board position
+     * @param info check info of the side to move
+     * @param moves output list, moves and scores are appended
+     */
+    template<PieceColor Us>
+    static void generateTactical(const Board &board, const CheckInfo &info, Move::MoveList &moves) {
+        const int first = moves.size();
+        generate<Us, GenType::CAPTURES>(board, info, moves);
+
+        for (int i = first; i < moves.size(); i++) {
+            moves.score[i] = mvvLva(board, moves[i]);
+        }
+    }
+
+    /**
+     * Most valuable victim first, least valuable attacker as tie break, promotions add
+     * the value of the new piece
+     */
+    static int32_t mvvLva(const Board &board, const Move::Move &move) {
+        const auto moveType = Move::moveType(move);
+        const auto attacker = board.pieceOn[Move::moveFrom(move)] % 6;
+        const auto target = board.pieceOn[Move::moveTo(move)];
+
+        int32_t score = -attacker;
+
+        if (moveType == Move::MoveType::MT_ENPASSANT) {
+            score += 16 * (PieceType::PAWN + 1);
+        } else if (target >= 0) {
+            score += 16 * (target % 6 + 1);
+        }
+
+        if (moveType == Move::MoveType::MT_PROMOTION) {
+            score += 16 * (decodePromo(Move::movePromo(move)) + 1);
+        }
+
+        return score;
+    }
+
+    /**
+     * Whether a legal move belongs to the CAPTURES group
+     */
+    static bool isTactical(const Board &board, const Move::Move &move) {
+        const auto moveType = Move::moveType(move);
+
+        if (moveType == Move::MoveType::MT_ENPASSANT) return true;
+        if (moveType == Move::MoveType::MT_CASTLE) return false;
+        if (board.pieceOn[Move::moveTo(move)] >= 0) return true;
+
+        return moveType == Move::MoveType::MT_PROMOTION && Move::movePromo(move) == Move::Promo::PR_QUEEN;
+    }
+
+    /**
+     * Whether a legal move of the side to move checks the enemy king, answered from the
+     * cached check state without making the move
+     */
+    template<PieceColor Us>
+    static bool givesCheck(const Board &board, const Move::Move &move) {
+        using Traits = ColorTraits<Us>;
+        constexpr PieceColor them = Traits::them;
+
+        const CheckState &state = board.getCheckState();
+        const auto from = Move::moveFrom(move);
+        const auto to = Move::moveTo(move);
+        const auto moveType = Move::moveType(move);
+        const uint8_t theirKing = board.kingSq[them];
+
+        // direct check, promotions and castles are resolved below
+        if (moveType != Move::MoveType::MT_PROMOTION && moveType != Move::MoveType::MT_CASTLE &&
+            (state.checkSquares[board.pieceOn[from] % 6] & Bitboards::bit(to))) {
+            return true;
+        }
+
+        // discovered check, the piece leaves the line between our slider and their king
+        if ((state.blockersForKing[them] & Bitboards::bit(from)) &&
+            !(preComputedMoves.line[from][theirKing] & Bitboards::bit(to))) {
+            return true;
+        }
+
+        const BitBoard ourDiagonal = board.pieces[Us][PieceType::BISHOP] | board.pieces[Us][PieceType::QUEEN];
+        const BitBoard ourOrthogonal = board.pieces[Us][PieceType::ROOK] | board.pieces[Us][PieceType::QUEEN];
+
+        switch (moveType) {
+            case Move::MoveType::MT_PROMOTION: {
+                const BitBoard occupancy = board.occupancyAll ^ Bitboards::bit(from);
+                switch (decodePromo(Move::movePromo(move))) {
+                    case PieceType::KNIGHT:
+                        return preComputedMoves.knight[to] & Bitboards::bit(theirKing);
+                    case PieceType::BISHOP:
+                        return preComputedMoves.getBishopAttacks(to, occupancy) & Bitboards::bit(theirKing);
+                    case PieceType::ROOK:
+                        return preComputedMoves.getRookAttacks(to, occupancy) & Bitboards::bit(theirKing);
+                    default:
+                        return preComputedMoves.getQueenAttacks(to, occupancy) & Bitboards::bit(theirKing);
+                }
+            }
+
+            case Move::MoveType::MT_ENPASSANT: {
+                // the captured pawn may uncover a line of ours as well
+                const auto capturedField = static_cast<uint8_t>(to - Traits::forward);
+                const BitBoard occupancy = (board.occupancyAll ^ Bitboards::bit(from) ^ Bitboards::bit(capturedField)) |
+                                           Bitboards::bit(to);
+
+                return (preComputedMoves.getBishopAttacks(theirKing, occupancy) & ourDiagonal) |
+                       (preComputedMoves.getRookAttacks(theirKing, occupancy) & ourOrthogonal);
+            }
+
+            case Move::MoveType::MT_CASTLE: {
+                const bool isShort = to == Traits::shortKingTo;
+                const uint8_t rookFrom = isShort ? Traits::shortRookFrom : Traits::longRookFrom;
+                const uint8_t rookTo = isShort ? Traits::shortRookTo : Traits::longRookTo;
+                const BitBoard occupancy = (board.occupancyAll ^ Bitboards::bit(from) ^ Bitboards::bit(rookFrom)) |
+                                           Bitboards::bit(to) | Bitboards::bit(rookTo);
+
+                return preComputedMoves.getRookAttacks(rookTo, occupancy) & Bitboards::bit(theirKing);
+            }
+
+            default:
+                return false;
+        }
+    }
+
+private:
+    template<PieceColor color>
+    static BitBoard getAttackedFields(const Board &board, const BitBoard &occupancy) {
+        BitBoard attacks = ColorTraits<color>::pawnAttacks(board.pieces[color][PieceType::PAWN]);
+
+        for (BitBoard temp = board.pieces[color][PieceType::KNIGHT]; temp; Bitboards::pop_lsb(temp)) {
+            attacks |= preComputedMoves.knight[Bitboards::lsb_index(temp)];
+        }
+
+        const BitBoard queens = board.pieces[color][PieceType::QUEEN];
+
+        for (BitBoard temp = board.pieces[color][PieceType::BISHOP] | queens; temp; Bitboards::pop_lsb(temp)) {
+            attacks |= preComputedMoves.getBishopAttacks(Bitboards::lsb_index(temp), occupancy);
+        }
+
+        for (BitBoard temp = board.pieces[color][PieceType::ROOK] | queens; temp; Bitboards::pop_lsb(temp)) {
+            attacks |= preComputedMoves.getRookAttacks(Bitboards::lsb_index(temp), occupancy);
+        }
+
+        attacks |= preComputedMoves.king[board.kingSq[color]];
+
+        return attacks;
+    }
+
+    template<PieceColor Us, GenType Type>
+    static BitBoard getTargets(const Board &board) {
+        if constexpr (Type == GenType::CAPTURES) return board.occupancy[ColorTraits<Us>::them];
+        else if constexpr (Type == GenType::QUIETS) return ~board.occupancyAll;
+        else return ~board.occupancy[Us];
+    }
+
+    template<PieceType type>
+    static BitBoard getSliderAttacks(const uint8_t &from, const BitBoard &occupancy) {
+        if constexpr (type == PieceType::BISHOP) return preComputedMoves.getBishopAttacks(from, occupancy);
+        else if constexpr (type == PieceType::ROOK) return preComputedMoves.getRookAttacks(from, occupancy);
+        else return preComputedMoves.getQueenAttacks(from, occupancy);
+    }
+
+    template<PieceColor Us, GenType Type, PieceType type>
+    static void getSliderMoves(
+        const Board &board,
+        const CheckInfo &info,
+        const BitBoard &sources,
+        Move::MoveList &moveList
+    ) {
+        const BitBoard targets = getTargets<Us, Type>(board) & info.checkMask;
+        const uint8_t kingPosition = board.kingSq[Us];
+
+        for (BitBoard temp = board.pieces[Us][type] & sources; temp; Bitboards::pop_lsb(temp)) {
+            const auto from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
+            auto moves = getSliderAttacks<type>(from, board.occupancyAll) & targets;
+
+            if (info.pinned & Bitboards::bit(from)) {
+                moves &= preComputedMoves.line[kingPosition][from];
+            }
+
+            emitMoves(from, moves, moveList);
+        }
+    }
+
+    template<PieceColor Us, GenType Type>
+    static void getKnightMoves(
+        const Board &board,
+        const CheckInfo &info,
+        const BitBoard &sources,
+        Move::MoveList &moveList
+    ) {
+        const BitBoard targets = getTargets<Us, Type>(board) & info.checkMask;
+
+        // a pinned knight can never move
+        for (BitBoard temp = board.pieces[Us][PieceType::KNIGHT] & sources & ~info.pinned; temp; Bitboards::pop_lsb(temp)) {
+            const auto from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
+            auto moves = preComputedMoves.knight[from] & targets;
+            emitMoves(from, moves, moveList);
+        }
+    }
+
+    template<PieceColor Us, GenType Type>
+    static void getKingMoves(
+        const Board &board,
+        const CheckInfo &info,
+        Move::MoveList &moveList
+    ) {
+        const uint8_t from = board.kingSq[Us];
+        auto moves = preComputedMoves.king[from] & getTargets<Us, Type>(board) & ~info.kingDanger;
+
+        emitMoves(from, moves, moveList);
+    }
+
+    template<PieceColor Us, GenType Type>
+    static void getPawnMoves(
+        const Board &board,
+        const CheckInfo &info,
+        const BitBoard &sources,
+        Move::MoveList &moveList
+    ) {
+        const BitBoard pawns = board.pieces[Us][PieceType::PAWN] & sources;
+        const uint8_t kingPosition = board.kingSq[Us];
+
+        emitPawnMoves<Us, Type>(board, pawns & ~info.pinned, info.checkMask, moveList);
+
+        // pinned pawns are rare, generate them one by one restricted to the pin line
+        // (a pinned piece can never resolve a check)
+        if (!info.checkers) {
+            for (BitBoard temp = pawns & info.pinned; temp; Bitboards::pop_lsb(temp)) {
+                const auto from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
+                emitPawnMoves<Us, Type>(board, Bitboards::bit(from), preComputedMoves.line[kingPosition][from], moveList);
+            }
+        }
+
+        if (Type != GenType::QUIETS) {
+            getEnPassantMoves<Us>(board, pawns, moveList);
+        }
+    }
+
+    template<PieceColor Us, GenType Type>
+    static void emitPawnMoves(
+        const Board &board,
+        const BitBoard &pawns,
+        const BitBoard &targetMask,
+        Move::MoveList &moveList
+    ) {
+        using Traits = ColorTraits<Us>;
+
+        const BitBoard enemyOccupation = board.occupancy[Traits::them] & targetMask;
+        const BitBoard empty = ~board.occupancyAll;
+
+        const BitBoard pushByOne = Bitboards::shift<Traits::forward>(pawns) & empty;
+        const BitBoard pushByTwo = Bitboards::shift<Traits::forward>(pushByOne & Traits::doublePushRow) & empty & targetMask;
+        const BitBoard pushes = pushByOne & targetMask;
+
+        if (Type != GenType::QUIETS) {
+            const BitBoard captureLeft = Bitboards::shift<Traits::forwardLeft>(pawns) & ~Bitboards::FILE_H & enemyOccupation;
+            const BitBoard captureRight = Bitboards::shift<Traits::forwardRight>(pawns) & ~Bitboards::FILE_A & enemyOccupation;
+
+            emitPawnTargets(captureLeft & ~Traits::promotionRow, Traits::forwardLeft, moveList);
+            emitPawnTargets(captureRight & ~Traits::promotionRow, Traits::forwardRight, moveList);
+            emitPromotions<true, true>(captureLeft & Traits::promotionRow, Traits::forwardLeft, moveList);
+            emitPromotions<true, true>(captureRight & Traits::promotionRow, Traits::forwardRight, moveList);
+        }
+
+        emitPromotions<Type != GenType::QUIETS, Type != GenType::CAPTURES>(pushes & Traits::promotionRow, Traits::forward, moveList);
+
+        if (Type != GenType::CAPTURES) {
+            emitPawnTargets(pushes & ~Traits::promotionRow, Traits::forward, moveList);
+            emitPawnTargets(pushByTwo, 2 * Traits::forward, moveList);
+        }
+    }
+
+    /**
+     * En passant removes two pawns from one row at once, so instead of pin masks the
+     * king is tested directly against the occupancy after the capture.
+     */
+    template<PieceColor Us>
+    static void getEnPassantMoves(
+        const Board &board,
+        const BitBoard &pawns,
+        Move::MoveList &moveList
+    ) {
+        if (board.ep == -1) return;
+
+        using Traits = ColorTraits<Us>;
+        constexpr PieceColor enemyColor = Traits::them;
+
+        const auto ep = static_cast<uint8_t>(board.ep);
+        const auto capturedField = static_cast<uint8_t>(ep - Traits::forward);
+        const uint8_t kingPosition = board.kingSq[Us];
+
+        // squares from which our pawn attacks ep are the squares an enemy pawn on ep would attack
+        BitBoard sources = ColorTraits<enemyColor>::pawnAttacks(Bitboards::bit(ep)) & pawns;
+
+        const BitBoard enemyDiagonal = board.pieces[enemyColor][PieceType::BISHOP] |
+                                       board.pieces[enemyColor][PieceType::QUEEN];
+        const BitBoard enemyOrthogonal = board.pieces[enemyColor][PieceType::ROOK] |
+                                         board.pieces[enemyColor][PieceType::QUEEN];
+        const BitBoard enemyPawns = board.pieces[enemyColor][PieceType::PAWN] & ~Bitboards::bit(capturedField);
+        const BitBoard pawnSources = Traits::pawnAttacks(Bitboards::bit(kingPosition));
+
+        for (; sources; Bitboards::pop_lsb(sources)) {
+            const auto from = static_cast<uint8_t>(Bitboards::lsb_index(sources));
+            const BitBoard occupancy = (board.occupancyAll ^ Bitboards::bit(from) ^ Bitboards::bit(capturedField)) |
+                                       Bitboards::bit(ep);
+
+            if (preComputedMoves.getBishopAttacks(kingPosition, occupancy) & enemyDiagonal) continue;
+            if (preComputedMoves.getRookAttacks(kingPosition, occupancy) & enemyOrthogonal) continue;
+            if (preComputedMoves.knight[kingPosition] & board.pieces[enemyColor][PieceType::KNIGHT]) continue;
+            if (pawnSources & enemyPawns) continue;
+
+            moveList.push(Move::encodeMove(from, ep, Move::MoveType::MT_ENPASSANT));
+        }
+    }
+
+    template<PieceColor Us>
+    static void getCastles(
+        const Board &board,
+        const CheckInfo &info,
+        Move::MoveList &moveList
+    ) {
+        using Traits = ColorTraits<Us>;
+
+        auto allowed = [&](const BitBoard &empty, const BitBoard &safe) {
+            return !(board.occupancyAll & empty) && !(info.kingDanger & safe);
+        };
+
+        if ((board.castle & Traits::shortCastleRight) && allowed(Traits::shortCastleEmpty, Traits::shortCastleSafe))
+            moveList.push(Move::encodeMove(Traits::kingFrom, Traits::shortKingTo, Move::MoveType::MT_CASTLE));
+        if ((board.castle & Traits::longCastleRight) && allowed(Traits::longCastleEmpty, Traits::longCastleSafe))
+            moveList.push(Move::encodeMove(Traits::kingFrom, Traits::longKingTo, Move::MoveType::MT_CASTLE));
+    }
+
+    static void emitPawnTargets(BitBoard targets, const int &offset, Move::MoveList &moveList) {
+        for (; targets; Bitboards::pop_lsb(targets)) {
+            const auto to = static_cast<uint8_t>(Bitboards::lsb_index(targets));
+            moveList.push(Move::encodeMove(to - offset, to, Move::MoveType::MT_NORMAL));
+        }
+    }
+
+    template<bool Queen, bool UnderPromotions>
+    static void emitPromotions(BitBoard targets, const int &offset, Move::MoveList &moveList) {
+        for (; targets; Bitboards::pop_lsb(targets)) {
+            const auto to = static_cast<uint8_t>(Bitboards::lsb_index(targets));
+            const auto from = to - offset;
+
+            if (Queen) {
+                moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_QUEEN));
+            }
+            if (UnderPromotions) {
+                moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_ROOK));
+                moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_BISHOP));
+                moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_KNIGHT));
+            }
+        }
+    }
+
+    static void emitMoves(const uint8_t &from, BitBoard &dest, Move::MoveList &out) {
+        while (dest) {
+            const auto to = static_cast<uint8_t>(Bitboards::lsb_index(dest));
+            out.push(Move::encodeMove(from, to, Move::MoveType::MT_NORMAL));
+            Bitboards::pop_lsb(dest);
+        }
+    }
+};
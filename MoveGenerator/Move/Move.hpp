@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <iostream>
+#include <string>
 
 namespace Move {
 
@@ -10,12 +11,37 @@ namespace Move {
 
     enum Promo : Move { PR_KNIGHT = 0, PR_BISHOP = 1, PR_ROOK = 2, PR_QUEEN = 3 };
 
+    static constexpr int MAX_MOVES = 256;
+
+    /**
+     * Fixed-capacity move list living on the stack of the searching thread.
+     * Storage is intentionally left uninitialized, only the first `count` slots are valid.
+     * Every move has a score slot used by move ordering.
+     */
     struct MoveList {
-        MoveList() {
-            m.reserve(256);
+        Move m[MAX_MOVES];
+        int32_t score[MAX_MOVES];
+        int count = 0;
+
+        void push(const Move &x) { m[count++] = x; }
+
+        void push(const Move &x, const int32_t &s) {
+            m[count] = x;
+            score[count] = s;
+            count++;
         }
-        std::vector<Move> m;
-        void push(const Move &x) { m.push_back(x); }
+
+        [[nodiscard]] int size() const { return count; }
+        [[nodiscard]] bool empty() const { return count == 0; }
+        void clear() { count = 0; }
+
+        Move &operator[](const int &i) { return m[i]; }
+        const Move &operator[](const int &i) const { return m[i]; }
+
+        Move *begin() { return m; }
+        Move *end() { return m + count; }
+        [[nodiscard]] const Move *begin() const { return m; }
+        [[nodiscard]] const Move *end() const { return m + count; }
     };
 
     /**
@@ -39,6 +65,20 @@ namespace Move {
     inline uint8_t moveTo(const Move &m) { return m & 0x3F; }
     inline MoveType moveType(const Move &m) { return static_cast<MoveType>((m >> 14) & 0x3); }
     inline Promo movePromo(const Move &m) { return static_cast<Promo>((m >> 12) & 0x3); }
+
+    /**
+     * @return move in UCI notation, e.g. e2e4, e7e8q
+     */
+    inline std::string toUci(const Move &m) {
+        std::string s;
+        for (const uint8_t sq: {moveFrom(m), moveTo(m)}) {
+            s += static_cast<char>('a' + (sq & 7));
+            s += static_cast<char>('1' + (sq >> 3));
+        }
+        if (moveType(m) == MT_PROMOTION) s += "nbrq"[movePromo(m)];
+        return s;
+    }
+
     /**
      *
      * @param from from position index
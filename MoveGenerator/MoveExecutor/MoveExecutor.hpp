@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 
 #include "UndoInfo.hpp"
 #include "../../Board/Board.hpp"
@@ -8,108 +9,118 @@
 
 class MoveExecutor {
 public:
+    static void makeMove(
+        Board &board,
+        const Move::Move &move,
+        UndoInfo &info
+    ) {
+        if (board.side == WHITE) makeMove<WHITE>(board, move, info);
+        else makeMove<BLACK>(board, move, info);
+    }
 
+    static void unmakeMove(
+        Board &board,
+        const Move::Move &move,
+        const UndoInfo &info
+    ) {
+        // after makeMove the side to move is the opponent of the player who moved
+        if (board.side == BLACK) unmakeMove<WHITE>(board, move, info);
+        else unmakeMove<BLACK>(board, move, info);
+    }
+
+    template<PieceColor Us>
     static void makeMove(
         Board &board,
         const Move::Move &move,
         UndoInfo &info
     ) {
+        using Traits = ColorTraits<Us>;
+        constexpr PieceColor opponent = Traits::them;
+
+        const auto moveFrom = Move::moveFrom(move);
+        const auto moveTo = Move::moveTo(move);
+        const auto moveType = Move::moveType(move);
+
         info.zobristBefore = board.zobrist;
+        info.pawnKeyBefore = board.pawnKey;
+        info.materialKeyBefore = board.materialKey;
+        info.materialBefore = board.materialScore;
+        info.pstBefore = board.pstScore;
         info.castleBefore = board.castle;
         info.epBefore = board.ep;
         info.halfMoveBefore = board.halfMove;
         info.fullMoveBefore = board.fullMove;
-        info.captured = board.pieceOn[Move::moveTo(move)];
-
-        const auto us = board.side;
-        const auto opponent = opponentColor(us);
-
-        const auto moveFrom = Move::moveFrom(move);
-        const auto moveTo = Move::moveTo(move);
-        const auto moveType = Move::moveType(move);
+        info.captured = board.pieceOn[moveTo];
 
-        const auto movedPieceCode = board.pieceOn[moveFrom];
-        const auto movedPieceType = static_cast<PieceType>(movedPieceCode % 6);
+        const auto movedPieceType = static_cast<PieceType>(board.pieceOn[moveFrom] % 6);
 
         board.ep = -1;
+        board.halfMove++;
 
-        if (moveType != Move::MT_ENPASSANT) {
-            const auto pieceOnTargetField = board.pieceOn[moveTo];
-            if (pieceOnTargetField >= 0) {
-                const auto pieceOnTargetFieldType = static_cast<PieceType>(pieceOnTargetField % 6);
-
-                board.removePiece(opponent, pieceOnTargetFieldType, moveTo);
-                board.clearCastleByCapture(opponent, moveTo);
-                board.halfMove = 0;
-            }
+        if (info.captured >= 0) {
+            board.removePiece(opponent, static_cast<PieceType>(info.captured % 6), moveTo);
+            board.halfMove = 0;
         }
 
-        board.clearCastleByMove(us, movedPieceType, moveFrom);
+        board.updateCastleRights(moveFrom, moveTo);
 
         switch (moveType) {
             case Move::MT_NORMAL:
-                board.movePiece(us, movedPieceType, moveFrom, moveTo);
+                board.movePiece(Us, movedPieceType, moveFrom, moveTo);
                 if (movedPieceType == PAWN) {
                     board.halfMove = 0;
-                    const int movedDistance = static_cast<int>(moveTo) - static_cast<int>(moveFrom);
-                    if (movedDistance == 16 || movedDistance == -16) {
-                        board.ep = (static_cast<int>(moveTo) + static_cast<int>(moveFrom)) / 2;
+                    if (moveTo - moveFrom == 2 * Traits::forward) {
+                        board.ep = moveFrom + Traits::forward;
                     }
-                } else {
-                    board.halfMove++;
                 }
                 break;
             case Move::MT_PROMOTION:
-                board.removePiece(us, movedPieceType, moveFrom);
-                board.setPiece(us, decodePromo(Move::movePromo(move)), moveTo);
+                board.removePiece(Us, PAWN, moveFrom);
+                board.setPiece(Us, decodePromo(Move::movePromo(move)), moveTo);
                 board.halfMove = 0;
                 break;
             case Move::MT_CASTLE:
-                if (us == WHITE) {
-                    if (moveTo == 6) {
-                        // short: e1->g1, h1->f1
-                        board.movePiece(WHITE, KING, 4, 6);
-                        board.movePiece(WHITE, ROOK, 7, 5);
-                    } else {
-                        // long: e1->c1, a1->d1
-                        board.movePiece(WHITE, KING, 4, 2);
-                        board.movePiece(WHITE, ROOK, 0, 3);
-                    }
-                    board.castle &= ~(1 | 2);
+                if (moveTo == Traits::shortKingTo) {
+                    board.movePiece(Us, KING, Traits::kingFrom, Traits::shortKingTo);
+                    board.movePiece(Us, ROOK, Traits::shortRookFrom, Traits::shortRookTo);
                 } else {
-                    if (moveTo == 62) {
-                        // short: e8->g8, h8->f8
-                        board.movePiece(BLACK, KING, 60, 62);
-                        board.movePiece(BLACK, ROOK, 63, 61);
-                    } else {
-                        // long: e8->c8, a8->d8
-                        board.movePiece(BLACK, KING, 60, 58);
-                        board.movePiece(BLACK, ROOK, 56, 59);
-                    }
-                    board.castle &= ~(4 | 8);
+                    board.movePiece(Us, KING, Traits::kingFrom, Traits::longKingTo);
+                    board.movePiece(Us, ROOK, Traits::longRookFrom, Traits::longRookTo);
                 }
-                board.halfMove++;
                 break;
             case Move::MT_ENPASSANT:
-                const auto capturedField = us == WHITE
-                                               ? static_cast<uint8_t>(moveTo - 8)
-                                               : static_cast<uint8_t>(moveTo + 8);
-                board.removePiece(opponent, PAWN, capturedField);
-                board.movePiece(us, PAWN, moveFrom, moveTo);
+                board.removePiece(opponent, PAWN, static_cast<uint8_t>(moveTo - Traits::forward));
+                board.movePiece(Us, PAWN, moveFrom, moveTo);
                 board.halfMove = 0;
                 break;
         };
 
-        board.side = opponentColor(us);
+        if (Us == BLACK) {
+            board.fullMove++;
+        }
+
+        board.side = opponent;
+
+        // pieces were hashed by Board, the rest of the state changes here
+        const auto &zobrist = Zobrist::instance();
+        board.zobrist ^= zobrist.sideRnd;
+        board.zobrist ^= zobrist.castlingRnd[info.castleBefore] ^ zobrist.castlingRnd[board.castle];
+        if (info.epBefore >= 0) board.zobrist ^= zobrist.epFileRnd[info.epBefore & 7];
+        if (board.ep >= 0) board.zobrist ^= zobrist.epFileRnd[board.ep & 7];
+
+#if defined(VERIFY_ZOBRIST)
+        verifyZobrist(board);
+#endif
     }
 
+    template<PieceColor Us>
     static void unmakeMove(
         Board &board,
         const Move::Move &move,
         const UndoInfo &info
     ) {
-        const auto opponent = board.side;
-        const auto us = opponentColor(opponent);
+        using Traits = ColorTraits<Us>;
+        constexpr PieceColor opponent = Traits::them;
 
         const auto moveFrom = Move::moveFrom(move);
         const auto moveTo = Move::moveTo(move);
@@ -117,84 +128,87 @@ public:
 
         switch (moveType) {
             case Move::MT_NORMAL: {
-                const auto movedPieceCode = board.pieceOn[moveTo];
-                const auto movedPieceType = static_cast<PieceType>(movedPieceCode % 6);
+                const auto movedPieceType = static_cast<PieceType>(board.pieceOn[moveTo] % 6);
 
-                board.movePiece(us, movedPieceType, moveTo, moveFrom);
+                board.movePiece(Us, movedPieceType, moveTo, moveFrom);
 
                 if (info.captured >= 0) {
-                    const auto capturedType =
-                            static_cast<PieceType>(info.captured % 6);
-                    board.setPiece(opponent, capturedType, moveTo);
+                    board.setPiece(opponent, static_cast<PieceType>(info.captured % 6), moveTo);
                 }
                 break;
             }
 
             case Move::MT_PROMOTION: {
-                const auto promoType = decodePromo(Move::movePromo(move));
-
-                board.removePiece(us, promoType, moveTo);
-                board.setPiece(us, PAWN, moveFrom);
+                board.removePiece(Us, decodePromo(Move::movePromo(move)), moveTo);
+                board.setPiece(Us, PAWN, moveFrom);
 
                 if (info.captured >= 0) {
-                    const auto capturedType =
-                            static_cast<PieceType>(info.captured % 6);
-                    board.setPiece(opponent, capturedType, moveTo);
+                    board.setPiece(opponent, static_cast<PieceType>(info.captured % 6), moveTo);
                 }
                 break;
             }
 
             case Move::MT_CASTLE: {
-                if (us == WHITE) {
-                    if (moveTo == 6) {
-                        board.movePiece(WHITE, KING, 6, 4);
-                        board.movePiece(WHITE, ROOK, 5, 7);
-                    } else {
-                        board.movePiece(WHITE, KING, 2, 4);
-                        board.movePiece(WHITE, ROOK, 3, 0);
-                    }
+                if (moveTo == Traits::shortKingTo) {
+                    board.movePiece(Us, KING, Traits::shortKingTo, Traits::kingFrom);
+                    board.movePiece(Us, ROOK, Traits::shortRookTo, Traits::shortRookFrom);
                 } else {
-                    if (moveTo == 62) {
-                        board.movePiece(BLACK, KING, 62, 60);
-                        board.movePiece(BLACK, ROOK, 61, 63);
-                    } else {
-                        board.movePiece(BLACK, KING, 58, 60);
-                        board.movePiece(BLACK, ROOK, 59, 56);
-                    }
+                    board.movePiece(Us, KING, Traits::longKingTo, Traits::kingFrom);
+                    board.movePiece(Us, ROOK, Traits::longRookTo, Traits::longRookFrom);
                 }
                 break;
             }
 
             case Move::MT_ENPASSANT: {
-                const auto capturedField = us == WHITE
-                                               ? static_cast<uint8_t>(moveTo - 8)
-                                               : static_cast<uint8_t>(moveTo + 8);
-
-                board.movePiece(us, PAWN, moveTo, moveFrom);
-                board.setPiece(opponent, PAWN, capturedField);
+                board.movePiece(Us, PAWN, moveTo, moveFrom);
+                board.setPiece(opponent, PAWN, static_cast<uint8_t>(moveTo - Traits::forward));
                 break;
             }
         }
 
         board.zobrist = info.zobristBefore;
+        board.pawnKey = info.pawnKeyBefore;
+        board.materialKey = info.materialKeyBefore;
+        board.materialScore = info.materialBefore;
+        board.pstScore = info.pstBefore;
         board.castle = info.castleBefore;
         board.ep = info.epBefore;
         board.halfMove = info.halfMoveBefore;
         board.fullMove = info.fullMoveBefore;
 
-        board.side = us;
+        board.side = Us;
+
+#if defined(VERIFY_ZOBRIST)
+        verifyZobrist(board);
+#endif
     }
 
-    static bool isCheck(const Board &board, const PieceColor &us) {
-        const auto enemyColor = opponentColor(us);
-        const auto kingPosition = board.kingSq[us];
+#if defined(VERIFY_ZOBRIST)
+    /**
+     * Debug builds (-DVERIFY_ZOBRIST=ON) compare the incremental keys with a full recomputation
+     */
+    static void verifyZobrist(const Board &board) {
+        if (board.zobrist != Zobrist::instance().computeKey(board)) {
+            throw std::logic_error("incremental zobrist key differs from Zobrist::computeKey");
+        }
+        if (board.pawnKey != Zobrist::instance().computePawnKey(board)) {
+            throw std::logic_error("incremental pawn key differs from Zobrist::computePawnKey");
+        }
+        if (board.materialKey != Zobrist::instance().computeMaterialKey(board)) {
+            throw std::logic_error("incremental material key differs from Zobrist::computeMaterialKey");
+        }
+    }
+#endif
 
-        const auto isCheck = PseudoLegalMovesGenerator::isSquareAttackedBy(
-            kingPosition,
-            enemyColor,
-            board
-        );
+    static bool isCheck(const Board &board, const PieceColor &us) {
+        if (us == WHITE) return isCheck<WHITE>(board);
+        return isCheck<BLACK>(board);
+    }
 
-        return isCheck;
+    template<PieceColor Us>
+    static bool isCheck(const Board &board) {
+        // the board keeps the check state of the side to move
+        if (board.side == Us) return board.isCheck();
+        return PseudoLegalMovesGenerator::isSquareAttackedBy<ColorTraits<Us>::them>(board.kingSq[Us], board);
     }
 };
@@ -4,6 +4,11 @@
 struct UndoInfo {
     BitBoard zobristBefore;
     BitBoard zobristAfter;
+    BitBoard pawnKeyBefore;
+    BitBoard materialKeyBefore;
+
+    int materialBefore;
+    int pstBefore;
 
     uint8_t castleBefore;
     int epBefore;
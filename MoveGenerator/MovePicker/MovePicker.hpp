@@ -0,0 +1,184 @@
+#pragma once
+#include <utility>
+
+#include "../../Board/Board.hpp"
+#include "../Move/Move.hpp"
+#include "../LegalMovesGenerator/LegalMovesGenerator.hpp"
+#include "../StaticExchange/StaticExchange.hpp"
+
+/**
+ * Staged move picker. Moves are generated lazily: TT move, captures (MVV-LVA order), killers,
+ * quiets (checks first, then by history) and captures losing material by SEE, so a node which
+ * cuts off early never pays for the later stages.
+ * @tparam Us side to move in the position the picker is built for
+ */
+template<PieceColor Us>
+class MovePicker {
+public:
+    /**
+     * @param killers two killer moves of the ply or nullptr
+     * @param history butterfly table [from][to] of the side to move or nullptr
+     */
+    MovePicker(
+        const Board &board,
+        const Move::Move &ttMove,
+        const Move::Move *killers,
+        const int (*history)[64] = nullptr
+    ) : board(board),
+        info(LegalMovesGenerator::computeCheckInfo<Us>(board)),
+        ttMove(ttMove),
+        killers{killers ? killers[0] : Move::Move{0}, killers ? killers[1] : Move::Move{0}},
+        history(history) {
+    }
+
+    /**
+     * @return next legal move or 0 when all moves were returned
+     */
+    Move::Move next() {
+        switch (stage) {
+            case Stage::TT_MOVE:
+                stage = Stage::GENERATE_CAPTURES;
+                if (ttMove && LegalMovesGenerator::isLegal<Us>(board, info, ttMove)) {
+                    return ttMove;
+                }
+                ttMove = 0;
+                [[fallthrough]];
+
+            case Stage::GENERATE_CAPTURES:
+                LegalMovesGenerator::generateTactical<Us>(board, info, moves);
+                index = 0;
+                stage = Stage::CAPTURES;
+                [[fallthrough]];
+
+            case Stage::CAPTURES:
+                while (index < moves.size()) {
+                    const auto move = pickBest();
+                    if (move == ttMove) continue;
+
+                    // losing exchanges wait at the front of the list until the quiets are done
+                    if (!StaticExchange::isAtLeast(board, move, 0)) {
+                        moves[badCaptures++] = move;
+                        continue;
+                    }
+                    return move;
+                }
+                stage = Stage::KILLERS;
+                index = 0;
+                [[fallthrough]];
+
+            case Stage::KILLERS:
+                while (index < 2) {
+                    const auto killer = killers[index++];
+                    if (isUsableKiller(killer)) return killer;
+                }
+                stage = Stage::GENERATE_QUIETS;
+                [[fallthrough]];
+
+            case Stage::GENERATE_QUIETS:
+                moves.count = badCaptures;
+                LegalMovesGenerator::generate<Us, LegalMovesGenerator::GenType::QUIETS>(board, info, moves);
+                index = badCaptures;
+                sortQuiets();
+                stage = Stage::QUIETS;
+                [[fallthrough]];
+
+            case Stage::QUIETS:
+                while (index < moves.size()) {
+                    const auto move = moves[index++];
+                    if (move != ttMove && move != killers[0] && move != killers[1]) return move;
+                }
+                stage = Stage::BAD_CAPTURES;
+                index = 0;
+                [[fallthrough]];
+
+            case Stage::BAD_CAPTURES:
+                if (index < badCaptures) return moves[index++];
+                stage = Stage::DONE;
+                [[fallthrough]];
+
+            case Stage::DONE:
+                return 0;
+        }
+
+        return 0;
+    }
+
+    [[nodiscard]] bool inCheck() const { return info.checkers != 0; }
+
+private:
+    enum class Stage {
+        TT_MOVE,
+        GENERATE_CAPTURES,
+        CAPTURES,
+        KILLERS,
+        GENERATE_QUIETS,
+        QUIETS,
+        BAD_CAPTURES,
+        DONE
+    };
+
+    /**
+     * Selection sort step: swap the best scored remaining move to index and return it
+     */
+    Move::Move pickBest() {
+        int best = index;
+        for (int i = index + 1; i < moves.size(); i++) {
+            if (moves.score[i] > moves.score[best]) best = i;
+        }
+
+        std::swap(moves[index], moves[best]);
+        std::swap(moves.score[index], moves.score[best]);
+
+        return moves[index++];
+    }
+
+    /**
+     * Quiet checks in front of the other quiets, history score within both groups.
+     * The check state is cached in the board. Insertion sort, the lists are short
+     */
+    void sortQuiets() {
+        for (int i = index; i < moves.size(); i++) {
+            const auto from = Move::moveFrom(moves[i]);
+            const auto to = Move::moveTo(moves[i]);
+
+            moves.score[i] = history ? history[from][to] : 0;
+            if (LegalMovesGenerator::givesCheck<Us>(board, moves[i])) moves.score[i] += CHECK_BONUS;
+        }
+
+        for (int i = index + 1; i < moves.size(); i++) {
+            const auto move = moves[i];
+            const auto score = moves.score[i];
+
+            int j = i;
+            for (; j > index && moves.score[j - 1] < score; j--) {
+                moves[j] = moves[j - 1];
+                moves.score[j] = moves.score[j - 1];
+            }
+            moves[j] = move;
+            moves.score[j] = score;
+        }
+    }
+
+    bool isUsableKiller(const Move::Move &killer) const {
+        if (!killer || killer == ttMove) return false;
+        if (LegalMovesGenerator::isTactical(board, killer)) return false;
+
+        return LegalMovesGenerator::isLegal<Us>(board, info, killer);
+    }
+
+    // above any history score
+    static constexpr int32_t CHECK_BONUS = 1 << 20;
+
+    const Board &board;
+    const LegalMovesGenerator::CheckInfo info;
+
+    Move::Move ttMove;
+    Move::Move killers[2];
+    const int (*history)[64];
+
+    Move::MoveList moves;
+    int index = 0;
+    // captures with a losing exchange, kept in moves[0, badCaptures)
+    int badCaptures = 0;
+    Stage stage = Stage::TT_MOVE;
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "PerftTable.hpp"
+#include "../../Engine/ThreadPool/ThreadPool.hpp"
+#include "../../Board/Board.hpp"
+#include "../LegalMovesGenerator/LegalMovesGenerator.hpp"
+#include "../MoveExecutor/MoveExecutor.hpp"
+
+/**
+ * Leaf node counting for move generator validation and throughput measurement.
+ * The last ply is bulk counted: moves at depth 1 are generated but never made.
+ */
+class Perft {
+public:
+    /**
+     * @param board position, restored on return
+     * @param depth remaining plies
+     * @param table optional subtree hash, nullptr disables it
+     * @return number of leaf nodes
+     */
+    static uint64_t perft(Board &board, const int depth, PerftTable *table = nullptr) {
+        if (board.side == WHITE) return perft<WHITE>(board, depth, table);
+        return perft<BLACK>(board, depth, table);
+    }
+
+    template<PieceColor Us>
+    static uint64_t perft(Board &board, const int depth, PerftTable *table) {
+        if (depth == 0) return 1;
+
+        Move::MoveList moves;
+        LegalMovesGenerator::generate<Us, LegalMovesGenerator::GenType::ALL>(
+            board, LegalMovesGenerator::computeCheckInfo<Us>(board), moves);
+
+        if (depth == 1) return moves.size();
+
+        BitBoard key = 0;
+        if (table) {
+            uint64_t cached;
+            key = PerftTable::positionKey(board);
+            if (table->probe(key, depth, cached)) return cached;
+        }
+
+        uint64_t nodes = 0;
+        for (const auto &move: moves) {
+            UndoInfo undo;
+            MoveExecutor::makeMove<Us>(board, move, undo);
+            nodes += perft<ColorTraits<Us>::them>(board, depth - 1, table);
+            MoveExecutor::unmakeMove<Us>(board, move, undo);
+        }
+
+        if (table) table->store(key, depth, nodes);
+
+        return nodes;
+    }
+
+    /**
+     * Leaf count below every root move
+     */
+    static std::vector<std::pair<Move::Move, uint64_t> > divide(
+        Board &board,
+        const int depth,
+        PerftTable *table = nullptr
+    ) {
+        std::vector<std::pair<Move::Move, uint64_t> > result;
+
+        for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+            UndoInfo undo;
+            MoveExecutor::makeMove(board, move, undo);
+            result.emplace_back(move, perft(board, depth - 1, table));
+            MoveExecutor::unmakeMove(board, move, undo);
+        }
+
+        return result;
+    }
+
+    /**
+     * Same as divide, with the subtrees two plies below the root spread over the pool.
+     * Every participating thread works on its own copy of the board, the counts are
+     * identical to the single threaded run.
+     */
+    static std::vector<std::pair<Move::Move, uint64_t> > divideParallel(
+        ThreadPool &pool,
+        Board &board,
+        const int depth,
+        PerftTable *table = nullptr
+    ) {
+        if (depth <= 2) return divide(board, depth, table);
+
+        const auto rootMoves = LegalMovesGenerator::generateLegalMoves(board);
+
+        // (root move index, reply) for every subtree of depth - 2
+        std::vector<std::pair<int, Move::Move> > tasks;
+        for (int i = 0; i < rootMoves.size(); i++) {
+            UndoInfo undo;
+            MoveExecutor::makeMove(board, rootMoves[i], undo);
+            for (const auto &reply: LegalMovesGenerator::generateLegalMoves(board)) {
+                tasks.emplace_back(i, reply);
+            }
+            MoveExecutor::unmakeMove(board, rootMoves[i], undo);
+        }
+
+        std::vector<std::atomic<uint64_t> > counts(rootMoves.size());
+        for (auto &count: counts) count.store(0, std::memory_order_relaxed);
+
+        std::atomic<size_t> nextTask{0};
+        std::atomic<int> active{0};
+        std::mutex doneMutex;
+        std::condition_variable doneCv;
+
+        const auto consume = [&] {
+            Board child = board;
+
+            for (size_t t; (t = nextTask.fetch_add(1, std::memory_order_relaxed)) < tasks.size();) {
+                const auto &[rootIndex, reply] = tasks[t];
+                const auto rootMove = rootMoves[rootIndex];
+                UndoInfo rootUndo, replyUndo;
+
+                MoveExecutor::makeMove(child, rootMove, rootUndo);
+                MoveExecutor::makeMove(child, reply, replyUndo);
+                const auto nodes = perft(child, depth - 2, table);
+                MoveExecutor::unmakeMove(child, reply, replyUndo);
+                MoveExecutor::unmakeMove(child, rootMove, rootUndo);
+
+                counts[rootIndex].fetch_add(nodes, std::memory_order_relaxed);
+            }
+
+            if (active.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lk(doneMutex);
+                doneCv.notify_all();
+            }
+        };
+
+        // the calling thread works too, like at a search split point
+        const unsigned toSpawn = pool.size() > 1 ? pool.size() - 1 : 0;
+        active.store(static_cast<int>(toSpawn) + 1, std::memory_order_relaxed);
+
+        for (unsigned i = 0; i < toSpawn; i++) {
+            pool.submit(consume);
+        }
+        consume();
+
+        {
+            std::unique_lock<std::mutex> lk(doneMutex);
+            doneCv.wait(lk, [&] {
+                return active.load(std::memory_order_acquire) == 0;
+            });
+        }
+
+        std::vector<std::pair<Move::Move, uint64_t> > result;
+        for (int i = 0; i < rootMoves.size(); i++) {
+            result.emplace_back(rootMoves[i], counts[i].load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+    static uint64_t perftParallel(ThreadPool &pool, Board &board, const int depth, PerftTable *table = nullptr) {
+        if (depth <= 2) return perft(board, depth, table);
+
+        uint64_t nodes = 0;
+        for (const auto &[move, count]: divideParallel(pool, board, depth, table)) nodes += count;
+        return nodes;
+    }
+};
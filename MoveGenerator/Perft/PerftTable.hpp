@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "../../Bitboard.h"
+#include "../../Board/Board.hpp"
+
+/**
+ * Hash of subtree leaf counts keyed by position and remaining depth.
+ * Single entry per slot, always replace. Entries are stored as (key ^ data, data)
+ * so a slot torn by concurrent writers never matches.
+ */
+class PerftTable {
+public:
+    explicit PerftTable(const size_t capacityMb) {
+        const size_t slots = std::max<size_t>(capacityMb, 1) * 1024ull * 1024ull / sizeof(Entry);
+        size_t pow2 = 1;
+        while (pow2 * 2 <= slots) pow2 <<= 1;
+
+        this->mask = pow2 - 1;
+        this->entries = std::make_unique<Entry[]>(pow2);
+    }
+
+    /**
+     * Board::zobrist covers pieces, side to move, castling rights and the ep file
+     */
+    static BitBoard positionKey(const Board &board) {
+        return board.zobrist;
+    }
+
+    bool probe(const BitBoard &key, const int depth, uint64_t &nodes) const {
+        const Entry &entry = this->entries[key & this->mask];
+        const uint64_t data = entry.data.load(std::memory_order_relaxed);
+        const uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+        if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth) return false;
+
+        nodes = data >> 8;
+        return true;
+    }
+
+    void store(const BitBoard &key, const int depth, const uint64_t &nodes) {
+        Entry &entry = this->entries[key & this->mask];
+        const uint64_t data = nodes << 8 | static_cast<uint64_t>(depth & 0xFF);
+
+        entry.data.store(data, std::memory_order_relaxed);
+        entry.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> check{0};
+        // nodes << 8 | depth
+        std::atomic<uint64_t> data{0};
+    };
+
+    size_t mask{0};
+    std::unique_ptr<Entry[]> entries;
+};
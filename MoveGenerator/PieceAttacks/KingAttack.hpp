@@ -3,7 +3,7 @@
 
 class KingAttack {
 public:
-    BitBoard static generateKingAttacks(const uint8_t &position) {
+    BitBoard static constexpr generateKingAttacks(const uint8_t &position) {
         const BitBoard pos = Bitboards::bit(position);
         BitBoard result = 0;
 
@@ -4,7 +4,7 @@
 
 class BishopRelevantMoveMask {
 public:
-    BitBoard static generateRelevantFieldsMask(const uint8_t &position) {
+    BitBoard static constexpr generateRelevantFieldsMask(const uint8_t &position) {
         BitBoard result = 0;
 
         const uint8_t row = Bitboards::row_of(position);
@@ -5,7 +5,7 @@
 class BishopSlidingAttack {
 public:
 
-    BitBoard static generateSlidingAttacks(const uint8_t &position, const BitBoard &occupancy) {
+    BitBoard static constexpr generateSlidingAttacks(const uint8_t &position, const BitBoard &occupancy) {
         BitBoard result = 0;
 
         const uint8_t row = Bitboards::row_of(position);
@@ -0,0 +1,129 @@
+#pragma once
+#include "../../Bitboard.h"
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+/**
+ * Attacks of a whole set of sliders at once with Kogge-Stone occluded fills, one fill
+ * per direction instead of one table lookup per piece. The AVX2 version runs the four
+ * directions shifting towards row 8 in one register and the four shifting towards row 1
+ * in another. The variant is chosen once from the CPU the program runs on.
+ */
+class FillSlidingAttack {
+    static constexpr BitBoard NOT_FILE_A = ~Bitboards::FILE_A;
+    static constexpr BitBoard NOT_FILE_H = ~Bitboards::FILE_H;
+
+    /**
+     * @param generators sliders moving in the direction
+     * @param empty empty squares
+     * @param wrap squares a step in the direction may land on
+     */
+    template<int Offset>
+    static constexpr BitBoard occludedFill(BitBoard generators, BitBoard empty, const BitBoard &wrap) {
+        empty &= wrap;
+        generators |= empty & Bitboards::shift<Offset>(generators);
+        empty &= Bitboards::shift<Offset>(empty);
+        generators |= empty & Bitboards::shift<2 * Offset>(generators);
+        empty &= Bitboards::shift<2 * Offset>(empty);
+        generators |= empty & Bitboards::shift<4 * Offset>(generators);
+
+        return Bitboards::shift<Offset>(generators) & wrap;
+    }
+
+    static bool cpuHasAvx2() {
+#if defined(__GNUC__) && defined(__x86_64__)
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+public:
+    enum class Mode {
+        AVX2,
+        SCALAR
+    };
+
+    static Mode detectMode() {
+        return cpuHasAvx2() ? Mode::AVX2 : Mode::SCALAR;
+    }
+
+    /**
+     * @param rookLike rooks and queens
+     * @param bishopLike bishops and queens
+     * @param occupancy all pieces
+     * @return union of the attacks of every slider
+     */
+    static BitBoard getAttacks(const BitBoard &rookLike, const BitBoard &bishopLike, const BitBoard &occupancy) {
+        static const Mode mode = detectMode();
+#if defined(__GNUC__) && defined(__x86_64__)
+        if (mode == Mode::AVX2) return getAttacksAvx2(rookLike, bishopLike, occupancy);
+#endif
+        return getAttacksScalar(rookLike, bishopLike, occupancy);
+    }
+
+    static constexpr BitBoard getAttacksScalar(
+        const BitBoard &rookLike,
+        const BitBoard &bishopLike,
+        const BitBoard &occupancy
+    ) {
+        const BitBoard empty = ~occupancy;
+
+        return occludedFill<8>(rookLike, empty, ~0ULL) |
+               occludedFill<-8>(rookLike, empty, ~0ULL) |
+               occludedFill<1>(rookLike, empty, NOT_FILE_A) |
+               occludedFill<-1>(rookLike, empty, NOT_FILE_H) |
+               occludedFill<9>(bishopLike, empty, NOT_FILE_A) |
+               occludedFill<7>(bishopLike, empty, NOT_FILE_H) |
+               occludedFill<-7>(bishopLike, empty, NOT_FILE_A) |
+               occludedFill<-9>(bishopLike, empty, NOT_FILE_H);
+    }
+
+#if defined(__GNUC__) && defined(__x86_64__)
+    __attribute__((target("avx2")))
+    static BitBoard getAttacksAvx2(const BitBoard &rookLike, const BitBoard &bishopLike, const BitBoard &occupancy) {
+        // lanes: north / south, east / west, north-east / south-west, north-west / south-east
+        const __m256i step1 = _mm256_setr_epi64x(8, 1, 9, 7);
+        const __m256i step2 = _mm256_setr_epi64x(16, 2, 18, 14);
+        const __m256i step4 = _mm256_setr_epi64x(32, 4, 36, 28);
+
+        const auto all = static_cast<long long>(~0ULL);
+        const auto notA = static_cast<long long>(NOT_FILE_A);
+        const auto notH = static_cast<long long>(NOT_FILE_H);
+        const __m256i wrapUp = _mm256_setr_epi64x(all, notA, notA, notH);
+        const __m256i wrapDown = _mm256_setr_epi64x(all, notH, notH, notA);
+
+        const __m256i generators = _mm256_setr_epi64x(static_cast<long long>(rookLike),
+                                                      static_cast<long long>(rookLike),
+                                                      static_cast<long long>(bishopLike),
+                                                      static_cast<long long>(bishopLike));
+        const __m256i empty = _mm256_set1_epi64x(static_cast<long long>(~occupancy));
+
+        __m256i up = generators;
+        __m256i upEmpty = _mm256_and_si256(empty, wrapUp);
+        up = _mm256_or_si256(up, _mm256_and_si256(upEmpty, _mm256_sllv_epi64(up, step1)));
+        upEmpty = _mm256_and_si256(upEmpty, _mm256_sllv_epi64(upEmpty, step1));
+        up = _mm256_or_si256(up, _mm256_and_si256(upEmpty, _mm256_sllv_epi64(up, step2)));
+        upEmpty = _mm256_and_si256(upEmpty, _mm256_sllv_epi64(upEmpty, step2));
+        up = _mm256_or_si256(up, _mm256_and_si256(upEmpty, _mm256_sllv_epi64(up, step4)));
+        up = _mm256_and_si256(_mm256_sllv_epi64(up, step1), wrapUp);
+
+        __m256i down = generators;
+        __m256i downEmpty = _mm256_and_si256(empty, wrapDown);
+        down = _mm256_or_si256(down, _mm256_and_si256(downEmpty, _mm256_srlv_epi64(down, step1)));
+        downEmpty = _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downEmpty, step1));
+        down = _mm256_or_si256(down, _mm256_and_si256(downEmpty, _mm256_srlv_epi64(down, step2)));
+        downEmpty = _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downEmpty, step2));
+        down = _mm256_or_si256(down, _mm256_and_si256(downEmpty, _mm256_srlv_epi64(down, step4)));
+        down = _mm256_and_si256(_mm256_srlv_epi64(down, step1), wrapDown);
+
+        const __m256i lanes = _mm256_or_si256(up, down);
+        __m128i half = _mm_or_si128(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+        half = _mm_or_si128(half, _mm_unpackhi_epi64(half, half));
+
+        return static_cast<BitBoard>(_mm_cvtsi128_si64(half));
+    }
+#endif
+};
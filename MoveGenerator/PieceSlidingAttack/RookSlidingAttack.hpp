@@ -4,7 +4,7 @@
 
 class RookSlidingAttack {
 public:
-    BitBoard static generateSlidingAttacks(const uint8_t &position, const BitBoard &occupancy) {
+    BitBoard static constexpr generateSlidingAttacks(const uint8_t &position, const BitBoard &occupancy) {
         BitBoard result = 0;
 
         const uint8_t row = Bitboards::row_of(position);
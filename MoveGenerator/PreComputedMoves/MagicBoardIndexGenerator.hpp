@@ -1,4 +1,6 @@
 #pragma once
+#include <vector>
+
 #include "../../Bitboard.h"
 #if defined(__x86_64__) || defined(_M_X64)
 #if defined(__BMI2__)
@@ -7,9 +9,25 @@
 #endif
 
 
+struct SliderMagic {
+    BitBoard mask;
+    // unused for PEXT
+    BitBoard magic;
+    // first entry of the square in the attack arena
+    uint32_t offset;
+    // 64 - popcount(mask), unused for PEXT
+    uint8_t shift;
+};
+
+/**
+ * Maps the relevant occupancy of a slider to an index in its attack table.
+ * Two layouts exist: PEXT (only when the build targets BMI2 and the CPU has it)
+ * and fancy magic multiply. The layout is chosen once when the tables are built
+ * and stored next to them, lookups never query the CPU.
+ */
 class MagicBoardIndexGenerator {
     static bool cpuHasBmi2() {
-#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if defined(__BMI2__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
         // dostępne od GCC/Clang: wykrywa *runtime* cechę CPU
         return __builtin_cpu_supports("bmi2");
 #else
@@ -17,26 +35,83 @@ class MagicBoardIndexGenerator {
 #endif
     }
 
-    static inline BitBoard pext64_soft(const BitBoard &x, BitBoard m){
-        BitBoard out=0, bb=1;
-        while(m){
-            BitBoard lsb = m & -m;
-            if(x & lsb) out |= bb;
-            m ^= lsb;
-            bb <<= 1;
-        }
-        return out;
+    // xorshift64*, fixed seeds keep the found magics identical between runs
+    static BitBoard nextRandom(BitBoard &state) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
     }
 
 public:
-    static BitBoard getId(const BitBoard& src, const BitBoard& mask) {
+    enum class Mode {
+        PEXT,
+        MAGIC
+    };
+
+    static Mode detectMode() {
+        return cpuHasBmi2() ? Mode::PEXT : Mode::MAGIC;
+    }
+
+    /**
+     * @param occupancy board occupancy, does not have to be masked
+     * @param entry magic record of the square
+     * @param mode layout the table was built with
+     * @return index relative to entry.offset
+     */
+    static BitBoard getIndex(
+        const BitBoard &occupancy,
+        const SliderMagic &entry,
+        [[maybe_unused]] const Mode &mode
+    ) {
 #if defined(__BMI2__)
-        if (MagicBoardIndexGenerator::cpuHasBmi2()) {
-            return _pext_u64(src, mask);
+        if (mode == Mode::PEXT) {
+            return _pext_u64(occupancy, entry.mask);
         }
 #endif
-        // const BitBoard magic = 0xA180022080400230ULL;
-        // const int k = Bitboards::popCount64(mask);
-        return pext64_soft(src,mask);
+        return ((occupancy & entry.mask) * entry.magic) >> entry.shift;
+    }
+
+    /**
+     * Search a magic which maps every occupancy subset to a slot holding its attack set
+     * (different subsets may share a slot when their attacks are equal)
+     * @param mask relevant fields of the slider
+     * @param occupancies all subsets of mask
+     * @param attacks attacks[i] for occupancies[i]
+     * @param seed PRNG seed, fixed per square
+     */
+    static BitBoard findMagic(
+        const BitBoard &mask,
+        const std::vector<BitBoard> &occupancies,
+        const std::vector<BitBoard> &attacks,
+        BitBoard seed
+    ) {
+        const int bits = Bitboards::popCount64(mask);
+        const int shift = 64 - bits;
+        const size_t size = 1u << bits;
+
+        std::vector<BitBoard> used(size);
+        std::vector<int> epoch(size, 0);
+
+        for (int attempt = 1;; attempt++) {
+            BitBoard magic;
+            do {
+                magic = nextRandom(seed) & nextRandom(seed) & nextRandom(seed);
+            } while (Bitboards::popCount64((mask * magic) >> 56) < 6);
+
+            bool ok = true;
+            for (size_t i = 0; i < occupancies.size() && ok; i++) {
+                const auto idx = (occupancies[i] * magic) >> shift;
+
+                if (epoch[idx] != attempt) {
+                    epoch[idx] = attempt;
+                    used[idx] = attacks[i];
+                } else if (used[idx] != attacks[i]) {
+                    ok = false;
+                }
+            }
+
+            if (ok) return magic;
+        }
     }
 };
@@ -1,68 +1,64 @@
 #pragma once
-#include <memory>
 
 #include "MagicBoardIndexGenerator.hpp"
+#include "SliderTables.hpp"
 #include "../../Bitboard.h"
 #include "../PieceAttacks/KingAttack.hpp"
 #include "../PieceAttacks/KnightAttack.hpp"
 #include "../PieceAttacks/PawnAttack.hpp"
-#include "../PieceRelevantFieldsMask/BishopRelevantMoveMask.hpp"
-#include "../PieceRelevantFieldsMask/QueenRelevantMoveMask.hpp"
-#include "../PieceRelevantFieldsMask/RookRelevantMoveMask.hpp"
 #include "../PieceSlidingAttack/BishopSlidingAttack.hpp"
-#include "../PieceSlidingAttack/QueenSlidingAttack.hpp"
 #include "../PieceSlidingAttack/RookSlidingAttack.hpp"
 
 struct PreComputedMoves {
-    std::vector<BitBoard> bishop[64];
-    std::vector<BitBoard> rook[64];
-    std::vector<BitBoard> queen[64];
-
-    BitBoard bishopMask[64]{};
-    BitBoard rookMask[64]{};
-    BitBoard queenMask[64]{};
+    // slider tables generated at build time (SliderTables.cpp) in the layout of indexMode
+    const SquareMagics *magics = nullptr;
+    const BitBoard *sliderAttacks = nullptr;
+    MagicBoardIndexGenerator::Mode indexMode = MagicBoardIndexGenerator::Mode::MAGIC;
 
     BitBoard knight[64]{};
     BitBoard king[64]{};
 
     BitBoard whitePawn[64]{};
     BitBoard blackPawn[64]{};
-};
 
+    // squares strictly between two aligned squares / full line through them (0 when not aligned)
+    BitBoard between[64][64]{};
+    BitBoard line[64][64]{};
 
-class PreComputedMovesGenerator {
-public:
-    static PreComputedMoves &instance() {
-        static PreComputedMoves instance = [] {
-            return generate();
-        }();
-
-        return instance;
+    [[nodiscard]] BitBoard getBishopAttacks(const uint8_t &position, const BitBoard &occupancy) const {
+        const SliderMagic &entry = magics[position].bishop;
+        return sliderAttacks[entry.offset + MagicBoardIndexGenerator::getIndex(occupancy, entry, indexMode)];
     }
 
-public:
-    void static precompute(
-        const uint8_t &position,
-        const BitBoard &mask,
-        std::vector<BitBoard> &targetTable,
-        BitBoard (*generateAttack)(const uint8_t &, const BitBoard &)
-    ) {
-        const int bits = Bitboards::popCount64(mask);
-        const size_t size = 1u << bits;
-        targetTable.assign(size, 0ULL);
-
-
-        for (const BitBoard subset: Bitboards::allSubsets(mask)) {
-            const auto idx = MagicBoardIndexGenerator::getId(subset, mask);
-
-            const BitBoard attacks = generateAttack(position, subset);
+    [[nodiscard]] BitBoard getRookAttacks(const uint8_t &position, const BitBoard &occupancy) const {
+        const SliderMagic &entry = magics[position].rook;
+        return sliderAttacks[entry.offset + MagicBoardIndexGenerator::getIndex(occupancy, entry, indexMode)];
+    }
 
-            targetTable[idx] = attacks;
-        }
+    // queen attacks are composed from the rook and bishop tables, a dedicated table
+    // indexed by both masks would need up to 2^21 entries per square
+    [[nodiscard]] BitBoard getQueenAttacks(const uint8_t &position, const BitBoard &occupancy) const {
+        return getRookAttacks(position, occupancy) | getBishopAttacks(position, occupancy);
     }
+};
 
-    PreComputedMoves static generate() {
-        PreComputedMoves moves;
+
+class PreComputedMovesGenerator {
+public:
+    /**
+     * Tables in the slider layout chosen once for this CPU
+     */
+    static const PreComputedMoves &instance();
+
+    static constexpr PreComputedMoves generate(
+        const SquareMagics *magics,
+        const BitBoard *sliderAttacks,
+        const MagicBoardIndexGenerator::Mode mode
+    ) {
+        PreComputedMoves moves{};
+        moves.magics = magics;
+        moves.sliderAttacks = sliderAttacks;
+        moves.indexMode = mode;
 
         for (uint8_t i = 0; i < 64; i++) {
             moves.king[i] = KingAttack::generateKingAttacks(i);
@@ -70,36 +66,73 @@ public:
 
             moves.whitePawn[i] = PawnAttack::generateWhitePawnAttacks(i);
             moves.blackPawn[i] = PawnAttack::generateBlackPawnAttacks(i);
-
-
-            moves.bishopMask[i] = BishopRelevantMoveMask::generateRelevantFieldsMask(i);
-            // MagicBoard for bishop
-            precompute(
-                i,
-                moves.bishopMask[i],
-                moves.bishop[i],
-                BishopSlidingAttack::generateSlidingAttacks
-            );
-
-            moves.rookMask[i] = RookRelevantMoveMask::generateRelevantFieldsMask(i);
-            // MagicBoard for rook
-            precompute(
-                i,
-                moves.rookMask[i],
-                moves.rook[i],
-                RookSlidingAttack::generateSlidingAttacks
-            );
-
-            moves.queenMask[i] = QueenRelevantMoveMask::generateRelevantFieldsMask(i);
-            // MagicBoard for queen
-            precompute(
-                i,
-                moves.queenMask[i],
-                moves.queen[i],
-                QueenSlidingAttack::generateSlidingAttacks
-            );
         }
 
+        precomputeLines(moves);
+
         return moves;
     };
+
+    /**
+     * Same leaper and line tables with another slider layout
+     */
+    static constexpr PreComputedMoves withSliders(
+        PreComputedMoves moves,
+        const SquareMagics *magics,
+        const BitBoard *sliderAttacks,
+        const MagicBoardIndexGenerator::Mode mode
+    ) {
+        moves.magics = magics;
+        moves.sliderAttacks = sliderAttacks;
+        moves.indexMode = mode;
+
+        return moves;
+    }
+
+    static constexpr void precomputeLines(PreComputedMoves &moves) {
+        for (uint8_t from = 0; from < 64; from++) {
+            const BitBoard rookEmpty = RookSlidingAttack::generateSlidingAttacks(from, 0ULL);
+            const BitBoard bishopEmpty = BishopSlidingAttack::generateSlidingAttacks(from, 0ULL);
+
+            for (uint8_t to = 0; to < 64; to++) {
+                const BitBoard ends = Bitboards::bit(from) | Bitboards::bit(to);
+
+                if (rookEmpty & Bitboards::bit(to)) {
+                    moves.between[from][to] =
+                            RookSlidingAttack::generateSlidingAttacks(from, Bitboards::bit(to)) &
+                            RookSlidingAttack::generateSlidingAttacks(to, Bitboards::bit(from));
+                    moves.line[from][to] =
+                            (rookEmpty & RookSlidingAttack::generateSlidingAttacks(to, 0ULL)) | ends;
+                } else if (bishopEmpty & Bitboards::bit(to)) {
+                    moves.between[from][to] =
+                            BishopSlidingAttack::generateSlidingAttacks(from, Bitboards::bit(to)) &
+                            BishopSlidingAttack::generateSlidingAttacks(to, Bitboards::bit(from));
+                    moves.line[from][to] =
+                            (bishopEmpty & BishopSlidingAttack::generateSlidingAttacks(to, 0ULL)) | ends;
+                }
+            }
+        }
+    }
 };
+
+// evaluated by the compiler, both sets live in .rodata
+inline constexpr PreComputedMoves magicPreComputedMoves = PreComputedMovesGenerator::generate(
+    SliderTables::magicSquares, SliderTables::magicAttacks, MagicBoardIndexGenerator::Mode::MAGIC);
+
+#if defined(__BMI2__)
+inline constexpr PreComputedMoves pextPreComputedMoves = PreComputedMovesGenerator::withSliders(
+    magicPreComputedMoves, SliderTables::pextSquares, SliderTables::pextAttacks, MagicBoardIndexGenerator::Mode::PEXT);
+#endif
+
+inline const PreComputedMoves &PreComputedMovesGenerator::instance() {
+#if defined(__BMI2__)
+    static const PreComputedMoves &instance = MagicBoardIndexGenerator::detectMode() == MagicBoardIndexGenerator::Mode::PEXT
+                                                  ? pextPreComputedMoves
+                                                  : magicPreComputedMoves;
+    return instance;
+#else
+    return magicPreComputedMoves;
+#endif
+}
+
+inline const PreComputedMoves &preComputedMoves = PreComputedMovesGenerator::instance();
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+
+#include "MagicBoardIndexGenerator.hpp"
+
+/**
+ * Magic records of both sliders on one square, one cache line per square
+ */
+struct alignas(64) SquareMagics {
+    SliderMagic rook;
+    SliderMagic bishop;
+};
+
+static_assert(sizeof(SquareMagics) == 64);
+
+/**
+ * Slider attack tables generated at build time by SliderTablesGenerator into SliderTables.cpp.
+ * Every square owns 2^popcount(mask) entries, all rook entries come first and all bishop
+ * entries after them. Both layouts are always present, the PEXT one is used only by code
+ * built for BMI2 running on a CPU which has it.
+ */
+namespace SliderTables {
+    constexpr size_t ROOK_TABLE_SIZE = 102400;
+    constexpr size_t BISHOP_TABLE_SIZE = 5248;
+    constexpr size_t TABLE_SIZE = ROOK_TABLE_SIZE + BISHOP_TABLE_SIZE;
+
+    extern const SquareMagics magicSquares[64];
+    alignas(64) extern const BitBoard magicAttacks[TABLE_SIZE];
+
+    extern const SquareMagics pextSquares[64];
+    alignas(64) extern const BitBoard pextAttacks[TABLE_SIZE];
+}
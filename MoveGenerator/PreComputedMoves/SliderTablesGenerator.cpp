@@ -0,0 +1,130 @@
+/**
+ * Build-time generator of the slider attack tables.
+ * Usage: slider_tables_generator <output.cpp>
+ * Writes SliderTables.cpp with the magic and the PEXT layout as const arrays so they end up
+ * in .rodata. Both are always emitted, targets linking the tables may differ in BMI2 support.
+ */
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "SliderTables.hpp"
+#include "../PieceRelevantFieldsMask/BishopRelevantMoveMask.hpp"
+#include "../PieceRelevantFieldsMask/RookRelevantMoveMask.hpp"
+#include "../PieceSlidingAttack/BishopSlidingAttack.hpp"
+#include "../PieceSlidingAttack/RookSlidingAttack.hpp"
+
+// per-row PRNG seeds for the magic search, these converge after few attempts
+static constexpr BitBoard MAGIC_SEEDS[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+struct TableSet {
+    SquareMagics squares[64]{};
+    std::vector<BitBoard> attacks = std::vector<BitBoard>(SliderTables::TABLE_SIZE, 0ULL);
+};
+
+static BitBoard pextSoft(const BitBoard &x, BitBoard m) {
+    BitBoard out = 0, bb = 1;
+    while (m) {
+        const BitBoard lsb = m & -m;
+        if (x & lsb) out |= bb;
+        m ^= lsb;
+        bb <<= 1;
+    }
+    return out;
+}
+
+/**
+ * Fill the entries of one slider on one square in both layouts
+ * @return number of entries used
+ */
+static size_t precompute(
+    const uint8_t &position,
+    const BitBoard &mask,
+    const uint32_t &offset,
+    TableSet &magicSet,
+    TableSet &pextSet,
+    SliderMagic SquareMagics::*slider,
+    BitBoard (*generateAttack)(const uint8_t &, const BitBoard &)
+) {
+    const int bits = Bitboards::popCount64(mask);
+
+    const std::vector<BitBoard> subsets = Bitboards::allSubsets(mask);
+    std::vector<BitBoard> attacks(subsets.size());
+    for (size_t i = 0; i < subsets.size(); i++) {
+        attacks[i] = generateAttack(position, subsets[i]);
+    }
+
+    const auto shift = static_cast<uint8_t>(64 - bits);
+    const BitBoard magic = MagicBoardIndexGenerator::findMagic(mask, subsets, attacks,
+                                                               MAGIC_SEEDS[Bitboards::row_of(position)]);
+
+    magicSet.squares[position].*slider = SliderMagic{mask, magic, offset, shift};
+    pextSet.squares[position].*slider = SliderMagic{mask, 0ULL, offset, shift};
+
+    for (size_t i = 0; i < subsets.size(); i++) {
+        magicSet.attacks[offset + ((subsets[i] * magic) >> shift)] = attacks[i];
+        pextSet.attacks[offset + pextSoft(subsets[i], mask)] = attacks[i];
+    }
+
+    return size_t{1} << bits;
+}
+
+static void writeMagic(std::ostream &out, const SliderMagic &m) {
+    out << "{0x" << std::hex << m.mask << "ULL, 0x" << m.magic << "ULL, " << std::dec << m.offset << ", "
+        << static_cast<int>(m.shift) << "}";
+}
+
+static void writeSet(std::ostream &out, const TableSet &set, const char *squaresName, const char *attacksName) {
+    out << "const SquareMagics " << squaresName << "[64] = {\n";
+    for (const auto &square: set.squares) {
+        out << "    {";
+        writeMagic(out, square.rook);
+        out << ", ";
+        writeMagic(out, square.bishop);
+        out << "},\n";
+    }
+    out << "};\n\n";
+
+    out << "alignas(64) const BitBoard " << attacksName << "[TABLE_SIZE] = {\n";
+    for (size_t i = 0; i < set.attacks.size(); i++) {
+        out << (i % 4 == 0 ? "    " : " ") << "0x" << std::hex << set.attacks[i] << std::dec << "ULL,";
+        if (i % 4 == 3) out << "\n";
+    }
+    out << "};\n";
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <output.cpp>" << std::endl;
+        return 1;
+    }
+
+    TableSet magicSet, pextSet;
+    uint32_t rookOffset = 0;
+    uint32_t bishopOffset = SliderTables::ROOK_TABLE_SIZE;
+
+    for (uint8_t i = 0; i < 64; i++) {
+        rookOffset += precompute(i, RookRelevantMoveMask::generateRelevantFieldsMask(i), rookOffset,
+                                 magicSet, pextSet, &SquareMagics::rook, RookSlidingAttack::generateSlidingAttacks);
+        bishopOffset += precompute(i, BishopRelevantMoveMask::generateRelevantFieldsMask(i), bishopOffset,
+                                   magicSet, pextSet, &SquareMagics::bishop,
+                                   BishopSlidingAttack::generateSlidingAttacks);
+    }
+
+    if (rookOffset != SliderTables::ROOK_TABLE_SIZE || bishopOffset != SliderTables::TABLE_SIZE) {
+        std::cerr << "unexpected slider table size" << std::endl;
+        return 1;
+    }
+
+    std::ofstream out(argv[1]);
+    out << "// generated by SliderTablesGenerator, do not edit\n"
+        << "#include \"MoveGenerator/PreComputedMoves/SliderTables.hpp\"\n\n"
+        << "namespace SliderTables {\n\n";
+    writeSet(out, magicSet, "magicSquares", "magicAttacks");
+    out << "\n";
+    writeSet(out, pextSet, "pextSquares", "pextAttacks");
+    out << "\n}\n";
+
+    return out ? 0 : 1;
+}
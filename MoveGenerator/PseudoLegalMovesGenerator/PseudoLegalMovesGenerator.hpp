@@ -1,105 +1,132 @@
 #pragma once
 #include "../../Bitboard.h"
 #include "../../Board/Board.hpp"
+#include "../PieceSlidingAttack/FillSlidingAttack.hpp"
 #include "../PreComputedMoves/PreComputedMoves.hpp"
 
-inline const PreComputedMoves &preComputedMoves = PreComputedMovesGenerator::instance();
-
 class PseudoLegalMovesGenerator {
 public:
     static BitBoard getFieldsAttackedByColor(
         const PieceColor &color,
         const Board &board
     ) {
-        const BitBoard occupancyAll = board.occupancyAll;
-        BitBoard attacks = 0ULL;
-
-        const BitBoard pawns = board.pieces[color][PieceType::PAWN];
-        if (color == PieceColor::WHITE) {
-            attacks |= ((pawns << 7) & ~Bitboards::FILE_H) | ((pawns << 9) & ~Bitboards::FILE_A);
-        } else {
-            attacks |= ((pawns >> 7) & ~Bitboards::FILE_A) | ((pawns >> 9) & ~Bitboards::FILE_H);
-        }
+        if (color == PieceColor::WHITE) return getFieldsAttackedByColor<PieceColor::WHITE>(board);
+        return getFieldsAttackedByColor<PieceColor::BLACK>(board);
+    }
 
-        const BitBoard knights = board.pieces[color][PieceType::KNIGHT];
-        for (BitBoard temp = knights; temp; Bitboards::pop_lsb(temp)) {
-            const auto position = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            attacks |= preComputedMoves.knight[position];
-        }
+    template<PieceColor color>
+    static BitBoard getFieldsAttackedByColor(const Board &board) {
+        const BitBoard occupancyAll = board.occupancyAll;
+        BitBoard attacks = getLeaperAttacks<color>(board);
 
         const BitBoard bishops = board.pieces[color][PieceType::BISHOP];
         for (BitBoard temp = bishops; temp; Bitboards::pop_lsb(temp)) {
             const auto position = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const auto mask = preComputedMoves.bishopMask[position];
-
-            const auto relevant = mask & occupancyAll;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-            attacks |= preComputedMoves.bishop[position][idx];
+            attacks |= preComputedMoves.getBishopAttacks(position, occupancyAll);
         }
 
         const BitBoard rooks = board.pieces[color][PieceType::ROOK];
         for (BitBoard temp = rooks; temp; Bitboards::pop_lsb(temp)) {
             const auto position = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const auto mask = preComputedMoves.rookMask[position];
-
-            const auto relevant = mask & occupancyAll;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-            attacks |= preComputedMoves.rook[position][idx];
+            attacks |= preComputedMoves.getRookAttacks(position, occupancyAll);
         }
 
         const BitBoard queens = board.pieces[color][PieceType::QUEEN];
         for (BitBoard temp = queens; temp; Bitboards::pop_lsb(temp)) {
             const auto position = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const auto mask = preComputedMoves.queenMask[position];
+            attacks |= preComputedMoves.getQueenAttacks(position, occupancyAll);
+        }
 
-            const auto relevant = mask & occupancyAll;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
+        return attacks;
+    }
 
-            attacks |= preComputedMoves.queen[position][idx];
-        }
+    /**
+     * Same map with every slider filled at once instead of a lookup per piece,
+     * pays off for whole board queries (mobility, king zone) with many sliders
+     */
+    static BitBoard getFieldsAttackedByColorFill(
+        const PieceColor &color,
+        const Board &board
+    ) {
+        if (color == PieceColor::WHITE) return getFieldsAttackedByColorFill<PieceColor::WHITE>(board);
+        return getFieldsAttackedByColorFill<PieceColor::BLACK>(board);
+    }
 
-        const BitBoard king = board.pieces[color][PieceType::KING];
-        attacks |= preComputedMoves.king[Bitboards::lsb_index(king)];
+    template<PieceColor color>
+    static BitBoard getFieldsAttackedByColorFill(const Board &board) {
+        const BitBoard queens = board.pieces[color][PieceType::QUEEN];
 
-        return attacks;
+        return getLeaperAttacks<color>(board) |
+               FillSlidingAttack::getAttacks(board.pieces[color][PieceType::ROOK] | queens,
+                                             board.pieces[color][PieceType::BISHOP] | queens,
+                                             board.occupancyAll);
     }
 
     static Move::MoveList generatePseudoLegalMoves(
         const Board &board
     ) {
         Move::MoveList moves;
-        moves.m.reserve(128);
 
-        const PieceColor side = board.side;
+        if (board.side == PieceColor::WHITE) generatePseudoLegalMoves<PieceColor::WHITE>(board, moves);
+        else generatePseudoLegalMoves<PieceColor::BLACK>(board, moves);
 
-        getQueenMoves(side, board, moves);
-        getRookMoves(side, board, moves);
-        getBishopMoves(side, board, moves);
-        getKnightMoves(side, board, moves);
+        return moves;
+    }
 
+    template<PieceColor side>
+    static void generatePseudoLegalMoves(
+        const Board &board,
+        Move::MoveList &moves
+    ) {
+        getQueenMoves<side>(board, moves);
+        getRookMoves<side>(board, moves);
+        getBishopMoves<side>(board, moves);
+        getKnightMoves<side>(board, moves);
 
-        if (side == PieceColor::WHITE) {
-            getWhitePawnMoves(board, moves);
-        } else {
-            getBlackPawnMoves(board, moves);
-        }
+        getPawnMoves<side>(board, moves);
 
+        getKingMovesWithoutCastle<side>(board, moves);
 
-        getKingMovesWithoutCastle(side, board, moves);
+        getCastles<side>(board, moves);
+    }
 
-        getCastles(side, board, moves);
 
-        return moves;
+    /**
+     * Pieces of both colors attacking a square, sliders see through the given occupancy
+     * so removed pieces uncover the ones behind them
+     */
+    static BitBoard attackersTo(const Board &board, const uint8_t position, const BitBoard &occupancy) {
+        const BitBoard queens = board.pieces[WHITE][PieceType::QUEEN] | board.pieces[BLACK][PieceType::QUEEN];
+        const BitBoard bishops = board.pieces[WHITE][PieceType::BISHOP] | board.pieces[BLACK][PieceType::BISHOP];
+        const BitBoard rooks = board.pieces[WHITE][PieceType::ROOK] | board.pieces[BLACK][PieceType::ROOK];
+
+        // white pawns attacking the square stand where a black pawn on it would attack and vice versa
+        return (preComputedMoves.blackPawn[position] & board.pieces[WHITE][PieceType::PAWN]) |
+               (preComputedMoves.whitePawn[position] & board.pieces[BLACK][PieceType::PAWN]) |
+               (preComputedMoves.knight[position] &
+                (board.pieces[WHITE][PieceType::KNIGHT] | board.pieces[BLACK][PieceType::KNIGHT])) |
+               (preComputedMoves.king[position] &
+                (board.pieces[WHITE][PieceType::KING] | board.pieces[BLACK][PieceType::KING])) |
+               (preComputedMoves.getBishopAttacks(position, occupancy) & (bishops | queens)) |
+               (preComputedMoves.getRookAttacks(position, occupancy) & (rooks | queens));
     }
 
-
     static bool isSquareAttackedBy(
         const uint8_t position,
         const PieceColor color,
         const Board &board
     ) {
+        if (color == PieceColor::WHITE) return isSquareAttackedBy<PieceColor::WHITE>(position, board);
+        return isSquareAttackedBy<PieceColor::BLACK>(position, board);
+    }
+
+    template<PieceColor color>
+    static bool isSquareAttackedBy(
+        const uint8_t position,
+        const Board &board
+    ) {
+        if (board.trackAttacks) return board.getAttackedBy(color) & Bitboards::bit(position);
+
         const BitBoard occ = board.occupancyAll;
 
         const BitBoard enemyPawns = board.pieces[color][PieceType::PAWN];
@@ -109,48 +136,40 @@ public:
         const BitBoard enemyQueens = board.pieces[color][PieceType::QUEEN];
         const BitBoard enemyKing = board.pieces[color][PieceType::KING];
 
-        const BitBoard sqBB = 1ULL << position;
-
-        if (color == PieceColor::WHITE) {
-            const BitBoard sources =
-                    ((sqBB >> 7) & ~Bitboards::FILE_H) |
-                    ((sqBB >> 9) & ~Bitboards::FILE_A);
-            if (enemyPawns & sources) return true;
-        } else {
-            const BitBoard sources =
-                    ((sqBB << 7) & ~Bitboards::FILE_A) |
-                    ((sqBB << 9) & ~Bitboards::FILE_H);
-            if (enemyPawns & sources) return true;
-        }
+        // attacking pawns stand where a pawn of the other color on this square would attack
+        if (enemyPawns & ColorTraits<ColorTraits<color>::them>::pawnAttacks(Bitboards::bit(position))) return true;
 
         if (enemyKnights & preComputedMoves.knight[position]) return true;
 
         if (enemyKing & preComputedMoves.king[position]) return true;
 
-        {
-            const BitBoard mask = preComputedMoves.bishopMask[position];
-            const BitBoard relevant = mask & occ;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-            const BitBoard attacksFromSq = preComputedMoves.bishop[position][idx];
+        if (preComputedMoves.getBishopAttacks(position, occ) & (enemyBishops | enemyQueens)) return true;
 
-            if (attacksFromSq & (enemyBishops | enemyQueens)) return true;
-        }
+        if (preComputedMoves.getRookAttacks(position, occ) & (enemyRooks | enemyQueens)) return true;
+
+        return false;
+    }
 
-        {
-            const BitBoard mask = preComputedMoves.rookMask[position];
-            const BitBoard relevant = mask & occ;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-            const BitBoard attacksFromSq = preComputedMoves.rook[position][idx];
+private:
+    // pawns, knights and king, shared by both attack maps
+    template<PieceColor color>
+    static BitBoard getLeaperAttacks(const Board &board) {
+        BitBoard attacks = ColorTraits<color>::pawnAttacks(board.pieces[color][PieceType::PAWN]);
 
-            if (attacksFromSq & (enemyRooks | enemyQueens)) return true;
+        const BitBoard knights = board.pieces[color][PieceType::KNIGHT];
+        for (BitBoard temp = knights; temp; Bitboards::pop_lsb(temp)) {
+            const auto position = static_cast<uint8_t>(Bitboards::lsb_index(temp));
+            attacks |= preComputedMoves.knight[position];
         }
 
-        return false;
+        const BitBoard king = board.pieces[color][PieceType::KING];
+        attacks |= preComputedMoves.king[Bitboards::lsb_index(king)];
+
+        return attacks;
     }
 
-private:
+    template<PieceColor color>
     static void getKingMovesWithoutCastle(
-        const PieceColor &color,
         const Board &board,
         Move::MoveList &moveList
     ) {
@@ -161,8 +180,8 @@ private:
         emitMoves(from, moves, moveList);
     }
 
+    template<PieceColor color>
     static void getKnightMoves(
-        const PieceColor &color,
         const Board &board,
         Move::MoveList &moveList
     ) {
@@ -175,8 +194,8 @@ private:
         }
     }
 
+    template<PieceColor color>
     static void getBishopMoves(
-        const PieceColor &color,
         const Board &board,
         Move::MoveList &moveList
     ) {
@@ -185,19 +204,14 @@ private:
 
         for (BitBoard temp = board.pieces[color][PieceType::BISHOP]; temp; Bitboards::pop_lsb(temp)) {
             const auto from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const auto mask = preComputedMoves.bishopMask[from];
-
-            const auto relevant = mask & occupancyAll;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-            auto moves = preComputedMoves.bishop[from][idx] & ~friendllyOccupation;
+            auto moves = preComputedMoves.getBishopAttacks(from, occupancyAll) & ~friendllyOccupation;
 
             emitMoves(from, moves, moveList);
         }
     }
 
+    template<PieceColor color>
     static void getRookMoves(
-        const PieceColor &color,
         const Board &board,
         Move::MoveList &moveList
     ) {
@@ -206,19 +220,14 @@ private:
 
         for (BitBoard temp = board.pieces[color][PieceType::ROOK]; temp; Bitboards::pop_lsb(temp)) {
             const auto from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const auto mask = preComputedMoves.rookMask[from];
-
-            const auto relevant = mask & occupancyAll;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-            auto moves = preComputedMoves.rook[from][idx] & ~friendllyOccupation;
+            auto moves = preComputedMoves.getRookAttacks(from, occupancyAll) & ~friendllyOccupation;
 
             emitMoves(from, moves, moveList);
         }
     }
 
+    template<PieceColor color>
     static void getQueenMoves(
-        const PieceColor &color,
         const Board &board,
         Move::MoveList &moveList
     ) {
@@ -227,109 +236,35 @@ private:
 
         for (BitBoard temp = board.pieces[color][PieceType::QUEEN]; temp; Bitboards::pop_lsb(temp)) {
             const auto from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const auto mask = preComputedMoves.queenMask[from];
-
-            const auto relevant = mask & occupancyAll;
-            const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-            auto moves = preComputedMoves.queen[from][idx] & ~friendllyOccupation;
+            auto moves = preComputedMoves.getQueenAttacks(from, occupancyAll) & ~friendllyOccupation;
 
             emitMoves(from, moves, moveList);
         }
     }
 
-    static void getWhitePawnMoves(const Board &board, Move::MoveList &moveList) {
-        const BitBoard enemyOccupation = board.occupancy[PieceColor::BLACK];
-        const BitBoard empty = ~board.occupancyAll;
-
-        const BitBoard pawns = board.pieces[PieceColor::WHITE][PieceType::PAWN];
-
-        const BitBoard pushByOne = (pawns << 8) & empty;
-        const BitBoard promotion = pushByOne & Bitboards::ROW_8;
-        const BitBoard normalMove = pushByOne & ~Bitboards::ROW_8;
-
-        for (BitBoard temp = normalMove; temp; Bitboards::pop_lsb(temp)) {
-            const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const uint8_t from = to - 8;
-
-            moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_NORMAL));
-        }
-
-        for (BitBoard temp = promotion; temp; Bitboards::pop_lsb(temp)) {
-            const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const uint8_t from = to - 8;
-
-            moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_QUEEN));
-            moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_ROOK));
-            moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_BISHOP));
-            moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_KNIGHT));
-        }
-
-        const BitBoard pushByTwoBetweenFields = ((pawns & Bitboards::ROW_2) << 8) & empty;
-        const BitBoard pushByTwo = (pushByTwoBetweenFields << 8) & empty;
-
-        for (BitBoard temp = pushByTwo; temp; Bitboards::pop_lsb(temp)) {
-            const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const uint8_t from = to - 16;
-
-            moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_NORMAL));
-        }
-
-        const BitBoard captureLeft = ((pawns << 7) & ~Bitboards::FILE_H) & enemyOccupation;
-        const BitBoard captureRight = ((pawns << 9) & ~Bitboards::FILE_A) & enemyOccupation;
+    template<PieceColor color>
+    static void getPawnMoves(const Board &board, Move::MoveList &moveList) {
+        using Traits = ColorTraits<color>;
 
-        auto emitCapture = [&](const BitBoard &capture, const int &shift) {
-            for (BitBoard temp = capture; temp; Bitboards::pop_lsb(temp)) {
-                const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-                const uint8_t from = to - shift;
-                if (to >= 56) {
-                    moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_QUEEN));
-                    moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_ROOK));
-                    moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_BISHOP));
-                    moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_KNIGHT));
-                } else {
-                    moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_NORMAL));
-                }
-            }
-        };
-
-        emitCapture(captureLeft, 7);
-        emitCapture(captureRight, 9);
-
-        if (board.ep != -1) {
-            const auto ep = static_cast<uint8_t>(board.ep);
-            const auto enpassantBitboard = Bitboards::bit(ep);
-            BitBoard src = ((enpassantBitboard >> 7) & ~Bitboards::FILE_A) | (
-                               (enpassantBitboard >> 9) & ~Bitboards::FILE_H);
-            src &= pawns;
-
-            for (BitBoard temp = src; temp; Bitboards::pop_lsb(temp)) {
-                auto const from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-                moveList.push(Move::encodeMove(from, ep, Move::MoveType::MT_ENPASSANT));
-            }
-        }
-    }
-
-    static void getBlackPawnMoves(const Board &board, Move::MoveList &moveList) {
-        const BitBoard enemyOccupation = board.occupancy[PieceColor::WHITE];
+        const BitBoard enemyOccupation = board.occupancy[Traits::them];
         const BitBoard empty = ~board.occupancyAll;
 
-        const BitBoard pawns = board.pieces[PieceColor::BLACK][PieceType::PAWN];
+        const BitBoard pawns = board.pieces[color][PieceType::PAWN];
 
-        const BitBoard pushByOne = (pawns >> 8) & empty;
-        const BitBoard promotion = pushByOne & Bitboards::ROW_1;
-        const BitBoard normalMove = pushByOne & ~Bitboards::ROW_1;
+        const BitBoard pushByOne = Bitboards::shift<Traits::forward>(pawns) & empty;
+        const BitBoard promotion = pushByOne & Traits::promotionRow;
+        const BitBoard normalMove = pushByOne & ~Traits::promotionRow;
 
         for (BitBoard temp = normalMove; temp; Bitboards::pop_lsb(temp)) {
             const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const uint8_t from = to + 8;
+            const uint8_t from = to - Traits::forward;
 
             moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_NORMAL));
         }
 
         for (BitBoard temp = promotion; temp; Bitboards::pop_lsb(temp)) {
             const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const uint8_t from = to + 8;
+            const uint8_t from = to - Traits::forward;
 
             moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_QUEEN));
             moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_ROOK));
@@ -337,24 +272,25 @@ private:
             moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_KNIGHT));
         }
 
-        const BitBoard pushByTwoBetweenFields = ((pawns & Bitboards::ROW_7) >> 8) & empty;
-        const BitBoard pushByTwo = (pushByTwoBetweenFields >> 8) & empty;
+        const BitBoard pushByTwo = Bitboards::shift<Traits::forward>(pushByOne & Traits::doublePushRow) & empty;
 
         for (BitBoard temp = pushByTwo; temp; Bitboards::pop_lsb(temp)) {
             const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-            const uint8_t from = to + 16;
+            const uint8_t from = to - 2 * Traits::forward;
 
             moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_NORMAL));
         }
 
-        const BitBoard captureLeft = ((pawns >> 9) & ~Bitboards::FILE_H) & enemyOccupation;
-        const BitBoard captureRight = ((pawns >> 7) & ~Bitboards::FILE_A) & enemyOccupation;
+        const BitBoard captureLeft = (Bitboards::shift<Traits::forwardLeft>(pawns) & ~Bitboards::FILE_H) &
+                                     enemyOccupation;
+        const BitBoard captureRight = (Bitboards::shift<Traits::forwardRight>(pawns) & ~Bitboards::FILE_A) &
+                                      enemyOccupation;
 
         auto emitCapture = [&](const BitBoard &capture, const int &shift) {
             for (BitBoard temp = capture; temp; Bitboards::pop_lsb(temp)) {
                 const auto to = static_cast<uint8_t>(Bitboards::lsb_index(temp));
-                const uint8_t from = to + shift;
-                if (to <= 8) {
+                const uint8_t from = to - shift;
+                if (Bitboards::bit(to) & Traits::promotionRow) {
                     moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_QUEEN));
                     moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_ROOK));
                     moveList.push(Move::encodeMove(from, to, Move::MoveType::MT_PROMOTION, Move::Promo::PR_BISHOP));
@@ -365,15 +301,13 @@ private:
             }
         };
 
-        emitCapture(captureLeft, 9);
-        emitCapture(captureRight, 7);
+        emitCapture(captureLeft, Traits::forwardLeft);
+        emitCapture(captureRight, Traits::forwardRight);
 
         if (board.ep != -1) {
             const auto ep = static_cast<uint8_t>(board.ep);
-            const auto enpassantBitboard = Bitboards::bit(ep);
-            BitBoard src = ((enpassantBitboard >> 9) & ~Bitboards::FILE_H) | (
-                               (enpassantBitboard << 7) & ~Bitboards::FILE_A);
-            src &= pawns;
+            // our pawns attacking ep stand where an enemy pawn on ep would attack
+            const BitBoard src = ColorTraits<Traits::them>::pawnAttacks(Bitboards::bit(ep)) & pawns;
 
             for (BitBoard temp = src; temp; Bitboards::pop_lsb(temp)) {
                 auto const from = static_cast<uint8_t>(Bitboards::lsb_index(temp));
@@ -382,38 +316,26 @@ private:
         }
     }
 
+    template<PieceColor color>
     static void getCastles(
-        const PieceColor &color,
         const Board &board,
         Move::MoveList &moveList
     ) {
-        const auto kingPosition = board.kingSq[color];
-        const auto enemyColor = opponentColor(color);
+        using Traits = ColorTraits<color>;
 
-        auto empty = [&](const std::initializer_list<uint8_t> &sqs) {
-            for (const uint8_t &s: sqs) {
-                if (board.occupancyAll & Bitboards::bit(s)) return false;
-            }
-            return true;
-        };
-        auto safe = [&](const std::initializer_list<uint8_t> &sqs) {
-            for (const uint8_t &s: sqs) {
-                if (isSquareAttackedBy(s, enemyColor, board)) return false;
+        auto safe = [&](BitBoard squares) {
+            for (squares |= Bitboards::bit(Traits::kingFrom); squares; Bitboards::pop_lsb(squares)) {
+                if (isSquareAttackedBy<Traits::them>(Bitboards::lsb_index(squares), board)) return false;
             }
             return true;
         };
 
-        if (color == WHITE) {
-            if ((board.castle & 1) && empty({5, 6}) && safe({4, 5, 6}))
-                moveList.push(Move::encodeMove(kingPosition, 6, Move::MoveType::MT_CASTLE));
-            if ((board.castle & 2) && empty({3, 2, 1}) && safe({4, 3, 2}))
-                moveList.push(Move::encodeMove(kingPosition, 2, Move::MoveType::MT_CASTLE));
-        } else {
-            if ((board.castle & 4) && empty({61, 62}) && safe({60, 61, 62}))
-                moveList.push(Move::encodeMove(kingPosition, 62, Move::MoveType::MT_CASTLE));
-            if ((board.castle & 8) && empty({59, 58, 57}) && safe({60, 59, 58}))
-                moveList.push(Move::encodeMove(kingPosition, 58, Move::MoveType::MT_CASTLE));
-        }
+        if ((board.castle & Traits::shortCastleRight) && !(board.occupancyAll & Traits::shortCastleEmpty) &&
+            safe(Traits::shortCastleSafe))
+            moveList.push(Move::encodeMove(Traits::kingFrom, Traits::shortKingTo, Move::MoveType::MT_CASTLE));
+        if ((board.castle & Traits::longCastleRight) && !(board.occupancyAll & Traits::longCastleEmpty) &&
+            safe(Traits::longCastleSafe))
+            moveList.push(Move::encodeMove(Traits::kingFrom, Traits::longKingTo, Move::MoveType::MT_CASTLE));
     }
 
 
@@ -0,0 +1,102 @@
+#pragma once
+#include <algorithm>
+
+#include "../../Bitboard.h"
+#include "../../Board/Board.hpp"
+#include "../../Board/PieceSquareTables.hpp"
+#include "../Move/Move.hpp"
+#include "../PseudoLegalMovesGenerator/PseudoLegalMovesGenerator.hpp"
+
+/**
+ * Static exchange evaluation: material outcome of the capture sequence on the target square
+ * when both sides always recapture with their least valuable attacker and may stop at any time.
+ * Sliders behind a piece which left the square join the sequence (x-rays).
+ */
+class StaticExchange {
+public:
+    /**
+     * @param board position before the move
+     * @param move capture, promotion or quiet move of the side to move
+     * @return material balance for the side making the move, 0 for castles
+     */
+    static int evaluate(const Board &board, const Move::Move &move) {
+        const auto from = Move::moveFrom(move);
+        const auto to = Move::moveTo(move);
+        const auto moveType = Move::moveType(move);
+
+        if (moveType == Move::MoveType::MT_CASTLE) return 0;
+
+        const auto mover = static_cast<PieceColor>(board.pieceOn[from] / 6);
+        auto attackerType = static_cast<PieceType>(board.pieceOn[from] % 6);
+        BitBoard occupancy = board.occupancyAll ^ Bitboards::bit(from);
+
+        int gain[32];
+        int depth = 0;
+
+        if (moveType == Move::MoveType::MT_ENPASSANT) {
+            gain[0] = PieceSquareTables::VALUE[PieceType::PAWN];
+            occupancy ^= Bitboards::bit(mover == WHITE ? to - 8 : to + 8);
+        } else {
+            gain[0] = board.pieceOn[to] >= 0 ? PieceSquareTables::VALUE[board.pieceOn[to] % 6] : 0;
+        }
+
+        if (moveType == Move::MoveType::MT_PROMOTION) {
+            attackerType = decodePromo(Move::movePromo(move));
+            gain[0] += PieceSquareTables::VALUE[attackerType] - PieceSquareTables::VALUE[PieceType::PAWN];
+        }
+
+        const BitBoard diagonal = board.pieces[WHITE][PieceType::BISHOP] | board.pieces[BLACK][PieceType::BISHOP] |
+                                  board.pieces[WHITE][PieceType::QUEEN] | board.pieces[BLACK][PieceType::QUEEN];
+        const BitBoard orthogonal = board.pieces[WHITE][PieceType::ROOK] | board.pieces[BLACK][PieceType::ROOK] |
+                                    board.pieces[WHITE][PieceType::QUEEN] | board.pieces[BLACK][PieceType::QUEEN];
+
+        BitBoard attackers = PseudoLegalMovesGenerator::attackersTo(board, to, occupancy) & occupancy;
+        PieceColor side = opponentColor(mover);
+
+        while (depth < 31) {
+            const BitBoard sideAttackers = attackers & board.occupancy[side];
+            if (!sideAttackers) break;
+
+            // piece standing on the square is captured next, its value is the speculative gain
+            depth++;
+            gain[depth] = PieceSquareTables::VALUE[attackerType] - gain[depth - 1];
+
+            attackerType = leastValuable(board, side, sideAttackers);
+            const BitBoard attacker = sideAttackers & board.pieces[side][attackerType];
+            const BitBoard square = attacker & -attacker;
+
+            occupancy ^= square;
+            attackers ^= square;
+
+            if (attackerType == PieceType::PAWN || attackerType == PieceType::BISHOP ||
+                attackerType == PieceType::QUEEN) {
+                attackers |= preComputedMoves.getBishopAttacks(to, occupancy) & diagonal & occupancy;
+            }
+            if (attackerType == PieceType::ROOK || attackerType == PieceType::QUEEN) {
+                attackers |= preComputedMoves.getRookAttacks(to, occupancy) & orthogonal & occupancy;
+            }
+
+            side = opponentColor(side);
+        }
+
+        // every side may decline to continue the exchange
+        while (depth) {
+            gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+            depth--;
+        }
+
+        return gain[0];
+    }
+
+    static bool isAtLeast(const Board &board, const Move::Move &move, const int &threshold) {
+        return evaluate(board, move) >= threshold;
+    }
+
+private:
+    static PieceType leastValuable(const Board &board, const PieceColor &side, const BitBoard &attackers) {
+        for (int type = PieceType::PAWN; type < PieceType::KING; type++) {
+            if (attackers & board.pieces[side][type]) return static_cast<PieceType>(type);
+        }
+        return PieceType::KING;
+    }
+};
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../Parser/Parser.cpp"
+#include "../../Board/Zobrist.hpp"
+#include "../../MoveGenerator/LegalMovesGenerator/LegalMovesGenerator.hpp"
+#include "../../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+
+TEST_CASE("incremental zobrist key matches a full recomputation", "[zobrist]") {
+    // castles, en passant, promotions and rook captures within two plies
+    auto board = Parser::loadFen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    const auto rootKey = board.zobrist;
+
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        UndoInfo undo;
+        MoveExecutor::makeMove(board, move, undo);
+        REQUIRE(board.zobrist == Zobrist::instance().computeKey(board));
+
+        for (const auto &reply: LegalMovesGenerator::generateLegalMoves(board)) {
+            UndoInfo replyUndo;
+            MoveExecutor::makeMove(board, reply, replyUndo);
+            REQUIRE(board.zobrist == Zobrist::instance().computeKey(board));
+            MoveExecutor::unmakeMove(board, reply, replyUndo);
+        }
+
+        MoveExecutor::unmakeMove(board, move, undo);
+        REQUIRE(board.zobrist == rootKey);
+    }
+}
+
+TEST_CASE("side to move, castling and ep change the zobrist key", "[zobrist]") {
+    const auto white = Parser::loadFen("r3k2r/8/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1");
+    const auto black = Parser::loadFen("r3k2r/8/8/3pP3/8/8/8/R3K2R b KQkq d6 0 1");
+    const auto noCastle = Parser::loadFen("r3k2r/8/8/3pP3/8/8/8/R3K2R w - d6 0 1");
+    const auto noEp = Parser::loadFen("r3k2r/8/8/3pP3/8/8/8/R3K2R w KQkq - 0 1");
+
+    REQUIRE(white.zobrist != black.zobrist);
+    REQUIRE(white.zobrist != noCastle.zobrist);
+    REQUIRE(white.zobrist != noEp.zobrist);
+}
+
+TEST_CASE("pawn and material keys follow promotions, captures and en passant", "[zobrist][pawn][material]") {
+    auto board = Parser::loadFen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    const auto &keys = Zobrist::instance();
+
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        UndoInfo undo;
+        MoveExecutor::makeMove(board, move, undo);
+
+        for (const auto &reply: LegalMovesGenerator::generateLegalMoves(board)) {
+            UndoInfo replyUndo;
+            MoveExecutor::makeMove(board, reply, replyUndo);
+            REQUIRE(board.pawnKey == keys.computePawnKey(board));
+            REQUIRE(board.materialKey == keys.computeMaterialKey(board));
+            MoveExecutor::unmakeMove(board, reply, replyUndo);
+        }
+
+        MoveExecutor::unmakeMove(board, move, undo);
+    }
+
+    // the same pieces on other squares share the material key, not the pawn key
+    const auto a = Parser::loadFen("4k3/pp6/8/8/8/8/PP6/4K3 w - - 0 1");
+    const auto b = Parser::loadFen("4k3/6pp/8/8/8/8/6PP/4K3 w - - 0 1");
+    REQUIRE(a.materialKey == b.materialKey);
+    REQUIRE(a.pawnKey != b.pawnKey);
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../../Parser/Parser.cpp"
+#include "../../../Engine/AlphaBeta/AlphaBeta.hpp"
+#include "../../../Engine/Utils/KeyHistory.hpp"
+#include "../../../Engine/Utils/SearchLimits.hpp"
+#include "../../../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+
+namespace {
+    BitBoard keyAfter(Board &board, const Move::Move &move) {
+        UndoInfo undo;
+        MoveExecutor::makeMove(board, move, undo);
+        const BitBoard key = board.zobrist;
+        MoveExecutor::unmakeMove(board, move, undo);
+        return key;
+    }
+
+    int search(Board &board, const std::vector<BitBoard> &gameKeys, const int depth) {
+        TranspositionTable table{1};
+        SearchLimits limits;
+        keyHistory.reset(gameKeys, board.zobrist);
+        return AlphaBeta::search(board, table, limits, depth, Evaluation::NEG_INF, Evaluation::INF, 0);
+    }
+
+    Move::Move findMove(const Board &board, const uint8_t from, const uint8_t to) {
+        for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+            if (Move::moveFrom(move) == from && Move::moveTo(move) == to) return move;
+        }
+        return 0;
+    }
+}
+
+TEST_CASE("Key history finds repetitions two plies apart within the half move clock", "[draws]") {
+    KeyHistory history;
+    history.reset({11, 12, 13, 14}, 15);
+
+    history.set(1, 16);
+    history.set(2, 13);
+    REQUIRE(history.isRepetition(2, 10));
+    // key 13 is three plies behind the irreversible move
+    REQUIRE_FALSE(history.isRepetition(2, 3));
+
+    // same key with the other side to move is not a repetition
+    history.set(2, 14);
+    REQUIRE_FALSE(history.isRepetition(2, 10));
+
+    KeyHistory helper;
+    helper.copyPrefix(history, 1);
+    helper.set(2, 13);
+    REQUIRE(helper.isRepetition(2, 10));
+}
+
+TEST_CASE("Search scores a repeated position as a draw", "[draws]") {
+    // white is a queen down, repeating the game is the best it can do
+    auto board = Parser::loadFen("3qk3/8/8/8/8/8/8/7K w - - 10 40");
+    const auto kingMove = findMove(board, 7, 6);
+    REQUIRE(kingMove);
+
+    REQUIRE(search(board, {}, 1) < 0);
+    REQUIRE(search(board, {keyAfter(board, kingMove), 1, 2}, 1) == Evaluation::DRAW);
+
+    // a pawn move or a capture was played since, the old position cannot come back
+    auto reset = Parser::loadFen("3qk3/8/8/8/8/8/8/7K w - - 2 40");
+    REQUIRE(search(reset, {keyAfter(reset, kingMove), 1, 2}, 1) < 0);
+}
+
+TEST_CASE("Fifty move rule draws unless the last move mates", "[draws]") {
+    auto board = Parser::loadFen("6k1/8/8/8/8/8/8/R5K1 w - - 99 80");
+    REQUIRE(search(board, {}, 2) == Evaluation::DRAW);
+
+    // Qa8 and Qg7 mate with the hundredth half move
+    auto mating = Parser::loadFen("6k1/Q7/6K1/8/8/8/8/8 w - - 99 80");
+    REQUIRE(search(mating, {}, 2) > Evaluation::MATE - 10);
+}
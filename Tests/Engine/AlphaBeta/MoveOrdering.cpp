@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../../Parser/Parser.cpp"
+#include "../../../Engine/AlphaBeta/AlphaBeta.hpp"
+#include "../../../MoveGenerator/MovePicker/MovePicker.hpp"
+
+namespace {
+    Move::Move findMove(const Board &board, const uint8_t from, const uint8_t to) {
+        for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+            if (Move::moveFrom(move) == from && Move::moveTo(move) == to) return move;
+        }
+        return 0;
+    }
+}
+
+TEST_CASE("Quiet moves are picked by history score", "[ordering]") {
+    const auto board = Parser::loadFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    int history[64][64] = {};
+    history[6][21] = 300; // g1f3
+    history[12][28] = 200; // e2e4
+    history[11][27] = -100; // d2d4
+
+    MovePicker<WHITE> picker(board, 0, nullptr, history);
+    REQUIRE(picker.next() == findMove(board, 6, 21));
+    REQUIRE(picker.next() == findMove(board, 12, 28));
+
+    Move::Move last = 0;
+    for (Move::Move move; (move = picker.next());) last = move;
+    REQUIRE(last == findMove(board, 11, 27));
+}
+
+TEST_CASE("Cutoffs reward the quiet move and penalize the quiets tried before it", "[ordering]") {
+    const auto board = Parser::loadFen("4k3/8/8/3p4/8/8/3Q4/4K3 w - - 0 1");
+    const auto cutoff = findMove(board, 11, 19); // Qd3
+    const auto tried = findMove(board, 11, 12); // Qe2
+    const auto capture = findMove(board, 11, 35); // Qxd5
+    REQUIRE(cutoff);
+    REQUIRE(tried);
+    REQUIRE(capture);
+
+    AlphaBeta::clearHistory();
+    AlphaBeta::clearKillers();
+    const Move::Move before[] = {capture, tried};
+    AlphaBeta::updateQuietStats<WHITE>(board, cutoff, 6, 3, before, 2);
+
+    REQUIRE(butterflyHistory[WHITE][11][19] > 0);
+    REQUIRE(butterflyHistory[WHITE][11][12] < 0);
+    REQUIRE(butterflyHistory[WHITE][11][35] == 0);
+    REQUIRE(killerMoves[3][0] == cutoff);
+
+    // repeated rewards saturate
+    for (int i = 0; i < 10000; i++) {
+        AlphaBeta::updateQuietStats<WHITE>(board, cutoff, 30, 3, nullptr, 0);
+    }
+    REQUIRE(butterflyHistory[WHITE][11][19] <= 16384);
+
+    // captures are ordered by MVV-LVA, the tables are left alone
+    AlphaBeta::clearHistory();
+    AlphaBeta::updateQuietStats<WHITE>(board, capture, 6, 4, nullptr, 0);
+    REQUIRE(butterflyHistory[WHITE][11][35] == 0);
+    REQUIRE(killerMoves[4][0] == 0);
+}
@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../../Parser/Parser.cpp"
+#include "../../../Engine/AlphaBeta/AlphaBeta.hpp"
+#include "../../../Engine/Utils/SearchLimits.hpp"
+#include "../../../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+
+namespace {
+    int quiesce(Board &board) {
+        SearchLimits limits;
+        return AlphaBeta::quiesce<WHITE>(board, limits, Evaluation::NEG_INF, Evaluation::INF, 0);
+    }
+}
+
+TEST_CASE("Quiescence resolves a winning capture", "[quiescence]") {
+    auto board = Parser::loadFen("4k3/8/8/3q4/4P3/8/8/4K3 w - - 0 1");
+
+    Move::Move capture = 0;
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        if (Move::moveTo(move) == 35) capture = move;
+    }
+    REQUIRE(capture);
+
+    UndoInfo undo;
+    MoveExecutor::makeMove(board, capture, undo);
+    const int afterCapture = -Evaluation::evaluate(board);
+    MoveExecutor::unmakeMove(board, capture, undo);
+
+    REQUIRE(quiesce(board) == afterCapture);
+}
+
+TEST_CASE("Quiescence stands pat instead of a losing capture", "[quiescence]") {
+    auto board = Parser::loadFen("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1");
+
+    REQUIRE(quiesce(board) == Evaluation::evaluate(board));
+}
+
+TEST_CASE("Quiescence searches evasions and finds mate", "[quiescence]") {
+    auto board = Parser::loadFen("6k1/5ppp/8/8/8/8/5PPP/r5K1 w - - 0 1");
+
+    REQUIRE(quiesce(board) == -Evaluation::MATE);
+}
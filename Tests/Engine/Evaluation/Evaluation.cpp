@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../../Parser/Parser.cpp"
+#include "../../../Engine/Evaluation/Evaluation.hpp"
+#include "../../../MoveGenerator/LegalMovesGenerator/LegalMovesGenerator.hpp"
+#include "../../../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+
+TEST_CASE("Start position evaluates to zero", "[evaluation]") {
+    const auto board = Parser::loadFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    REQUIRE(board.materialScore == 0);
+    REQUIRE(board.pstScore == 0);
+    REQUIRE(Evaluation::evaluate(board) == 0);
+}
+
+TEST_CASE("Running material and PST sums follow make and unmake", "[evaluation]") {
+    // captures, promotions with capture, castles and en passant within two plies
+    auto board = Parser::loadFen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    const int material = board.materialScore;
+    const int pst = board.pstScore;
+
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        UndoInfo undo;
+        MoveExecutor::makeMove(board, move, undo);
+
+        for (const auto &reply: LegalMovesGenerator::generateLegalMoves(board)) {
+            UndoInfo replyUndo;
+            MoveExecutor::makeMove(board, reply, replyUndo);
+
+            Board fresh;
+            for (uint8_t position = 0; position < 64; position++) {
+                const int8_t piece = board.pieceOn[position];
+                if (piece >= 0) {
+                    fresh.setPiece(static_cast<PieceColor>(piece / 6), static_cast<PieceType>(piece % 6), position);
+                }
+            }
+            REQUIRE(board.materialScore == fresh.materialScore);
+            REQUIRE(board.pstScore == fresh.pstScore);
+
+            MoveExecutor::unmakeMove(board, reply, replyUndo);
+        }
+
+        MoveExecutor::unmakeMove(board, move, undo);
+    }
+
+    REQUIRE(board.materialScore == material);
+    REQUIRE(board.pstScore == pst);
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "../../../Parser/Parser.cpp"
+#include "../../../Engine/Engine.hpp"
+
+namespace {
+    const std::string middleGame = "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10";
+
+    bool isLegal(const Board &board, const Move::Move &move) {
+        for (const auto &legal: LegalMovesGenerator::generateLegalMoves(board)) {
+            if (legal == move) return true;
+        }
+        return false;
+    }
+
+    SearchConfig deepConfig(const unsigned threads) {
+        SearchConfig config;
+        config.maxDepth = 64;
+        config.threads = threads;
+        config.splitMinDepth = 2;
+        config.splitMinMoves = 16;
+        return config;
+    }
+}
+
+TEST_CASE("Node limit stops the search with the last completed iteration", "[limits]") {
+    auto board = Parser::loadFen(middleGame);
+    auto config = deepConfig(1);
+    config.maxNodes = 20000;
+
+    int completed = 0;
+    Move::Move lastMove = 0;
+    config.onIteration = [&](const IterationInfo &info) {
+        completed = info.depth;
+        lastMove = info.bestMove;
+    };
+
+    TranspositionTable table{8};
+    SearchLimits limits;
+    const auto [score, bestMove] = Engine::run(board, config, table, limits);
+
+    REQUIRE(completed > 0);
+    REQUIRE(completed < config.maxDepth);
+    REQUIRE(bestMove == lastMove);
+    REQUIRE(isLegal(board, bestMove));
+    // nodes are published in batches, every thread may overshoot by one batch
+    REQUIRE(limits.nodes() < config.maxNodes + 2 * SearchStats::FLUSH_INTERVAL);
+}
+
+TEST_CASE("Hard deadline bounds the search time on every thread", "[limits]") {
+    auto board = Parser::loadFen(middleGame);
+    auto config = deepConfig(4);
+    config.hardTimeMs = 100;
+
+    TranspositionTable table{8};
+    const auto start = std::chrono::steady_clock::now();
+    const auto [score, bestMove] = Engine::run(board, config, table);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(elapsed < std::chrono::seconds(2));
+    REQUIRE(isLegal(board, bestMove));
+}
+
+TEST_CASE("External stop returns a legal move", "[limits]") {
+    auto board = Parser::loadFen(middleGame);
+    const auto config = deepConfig(2);
+
+    TranspositionTable table{8};
+    SearchLimits limits;
+    std::thread stopper([&limits] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        limits.stop();
+    });
+    const auto [score, bestMove] = Engine::run(board, config, table, limits);
+    stopper.join();
+
+    REQUIRE(isLegal(board, bestMove));
+}
+
+TEST_CASE("Stop requested before the search starts is not lost", "[limits]") {
+    auto board = Parser::loadFen(middleGame);
+    auto config = deepConfig(2);
+
+    int completed = 0;
+    config.onIteration = [&](const IterationInfo &info) { completed = info.depth; };
+
+    TranspositionTable table{8};
+    SearchLimits limits;
+    limits.stop();
+    const auto [score, bestMove] = Engine::run(board, config, table, limits);
+
+    REQUIRE(completed == 0);
+    REQUIRE(isLegal(board, bestMove));
+}
+
+TEST_CASE("Concurrent searches keep their own limits", "[limits]") {
+    auto board = Parser::loadFen(middleGame);
+    auto limited = deepConfig(2);
+    limited.maxNodes = 20000;
+
+    auto unlimited = deepConfig(2);
+    unlimited.maxDepth = 5;
+    int completed = 0;
+    unlimited.onIteration = [&](const IterationInfo &info) { completed = info.depth; };
+
+    std::thread other([&board, &limited] {
+        Board copy = board;
+        TranspositionTable table{8};
+        Engine::run(copy, limited, table);
+    });
+    Board copy = board;
+    TranspositionTable table{8};
+    Engine::run(copy, unlimited, table);
+    other.join();
+
+    REQUIRE(completed == unlimited.maxDepth);
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../Parser/Parser.cpp"
+#include "../../MoveGenerator/LegalMovesGenerator/LegalMovesGenerator.hpp"
+#include "../../MoveGenerator/MoveExecutor/MoveExecutor.hpp"
+
+TEST_CASE("Count legal moves from start position", "[legal][moves]") {
+    const auto board = Parser::loadFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    REQUIRE(LegalMovesGenerator::generateLegalMoves(board).size() == 20);
+}
+
+TEST_CASE("Count legal moves in Kiwipete", "[legal][moves]") {
+    const auto board = Parser::loadFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+    REQUIRE(LegalMovesGenerator::generateLegalMoves(board).size() == 48);
+}
+
+TEST_CASE("Pinned pieces move only along the pin line", "[legal][pin]") {
+    // white rook on e2 pinned by the queen on e8, bishop on d2 pinned by the bishop on a5
+    const auto board = Parser::loadFen("4q2k/8/8/b7/8/8/3BR3/4K3 w - - 0 1");
+    const auto info = LegalMovesGenerator::computeCheckInfo(board, PieceColor::WHITE);
+
+    REQUIRE(info.pinned == (Bitboards::bit(11) | Bitboards::bit(12)));
+    REQUIRE(info.checkers == 0);
+
+    // rook: e3..e8 (6), bishop: c3, b4, a5 (3), king: d1, f1, f2 (3)
+    REQUIRE(LegalMovesGenerator::generateLegalMoves(board).size() == 12);
+}
+
+TEST_CASE("Double check allows only king moves", "[legal][check]") {
+    const auto board = Parser::loadFen("4k3/8/8/8/1b6/5N2/8/r3K3 w - - 0 1");
+    const auto info = LegalMovesGenerator::computeCheckInfo(board, PieceColor::WHITE);
+
+    REQUIRE(Bitboards::popCount64(info.checkers) == 2);
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        REQUIRE(Move::moveFrom(move) == 4);
+    }
+}
+
+TEST_CASE("En passant exposing the king on the row is illegal", "[legal][enpassant]") {
+    const auto board = Parser::loadFen("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1");
+
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        REQUIRE(Move::moveType(move) != Move::MoveType::MT_ENPASSANT);
+    }
+}
+
+TEST_CASE("En passant capturing the checking pawn is legal", "[legal][enpassant]") {
+    const auto board = Parser::loadFen("8/8/8/2k5/3Pp3/8/8/4K3 b - d3 0 1");
+
+    bool found = false;
+    for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+        found |= Move::moveType(move) == Move::MoveType::MT_ENPASSANT;
+    }
+    REQUIRE(found);
+}
+
+TEST_CASE("Tactical generator emits only captures and promotions with MVV-LVA scores", "[legal][tactical]") {
+    // white pawn on b7 may capture the rook on a8 or push to b8, queen on d1 attacks the queen on d8
+    const auto board = Parser::loadFen("r2q3k/1P6/8/8/8/8/8/3QK3 w - - 0 1");
+    const auto info = LegalMovesGenerator::computeCheckInfo(board, PieceColor::WHITE);
+
+    Move::MoveList moves;
+    LegalMovesGenerator::generateTactical<PieceColor::WHITE>(board, info, moves);
+
+    // bxa8 with 4 promotions, b8=Q, Qxd8
+    int32_t queenCaptureByQueen = 0;
+    for (int i = 0; i < moves.size(); i++) {
+        REQUIRE(LegalMovesGenerator::isTactical(board, moves[i]));
+        if (moves[i] == Move::encodeMove(3, 59)) queenCaptureByQueen = moves.score[i];
+    }
+    REQUIRE(moves.size() == 6);
+
+    // pawn takes rook and promotes to queen beats queen takes queen
+    const auto bestPromotion = Move::encodeMove(49, 56, Move::MoveType::MT_PROMOTION, Move::Promo::PR_QUEEN);
+    REQUIRE(LegalMovesGenerator::mvvLva(board, bestPromotion) > queenCaptureByQueen);
+}
+
+TEST_CASE("givesCheck agrees with the check state after the move", "[legal][check]") {
+    for (const auto &fen: {
+             "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+             "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+             // discovered check by the rook after e5xd6 en passant, long castle checks on d1
+             "8/8/8/2kpP2R/8/8/8/R3K3 w Q d6 0 1",
+             "8/8/8/8/8/8/8/R3K2k w Q - 0 1",
+         }) {
+        auto board = Parser::loadFen(fen);
+
+        for (const auto &move: LegalMovesGenerator::generateLegalMoves(board)) {
+            const bool expected = LegalMovesGenerator::givesCheck<WHITE>(board, move);
+
+            UndoInfo undo;
+            MoveExecutor::makeMove(board, move, undo);
+            REQUIRE(board.isCheck() == expected);
+            MoveExecutor::unmakeMove(board, move, undo);
+        }
+    }
+}
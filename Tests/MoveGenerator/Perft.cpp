@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../Parser/Parser.cpp"
+#include "../../MoveGenerator/Perft/Perft.hpp"
+
+TEST_CASE("Perft of the standard positions", "[perft]") {
+    auto start = Parser::loadFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    auto kiwipete = Parser::loadFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    auto endgame = Parser::loadFen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+    auto promotions = Parser::loadFen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+
+    REQUIRE(Perft::perft(start, 4) == 197281);
+    REQUIRE(Perft::perft(kiwipete, 3) == 97862);
+    REQUIRE(Perft::perft(endgame, 5) == 674624);
+    REQUIRE(Perft::perft(promotions, 3) == 9467);
+}
+
+TEST_CASE("Perft hash gives the same counts", "[perft][hash]") {
+    auto kiwipete = Parser::loadFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    PerftTable table{4};
+
+    REQUIRE(Perft::perft(kiwipete, 4, &table) == 4085603);
+    REQUIRE(Perft::perft(kiwipete, 4, &table) == 4085603);
+}
+
+TEST_CASE("Divide sums up to perft", "[perft][divide]") {
+    auto kiwipete = Parser::loadFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    const auto divided = Perft::divide(kiwipete, 2);
+
+    uint64_t total = 0;
+    for (const auto &[move, nodes]: divided) total += nodes;
+
+    REQUIRE(divided.size() == 48);
+    REQUIRE(total == 2039);
+}
+
+TEST_CASE("Parallel perft matches the single threaded count", "[perft][parallel]") {
+    auto kiwipete = Parser::loadFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    ThreadPool pool{4};
+
+    REQUIRE(Perft::perftParallel(pool, kiwipete, 4) == Perft::perft(kiwipete, 4));
+    REQUIRE(Perft::perftParallel(pool, kiwipete, 2) == 2039);
+}
+
+TEST_CASE("Perft with incremental attack maps gives the same counts", "[perft][attacks]") {
+    auto kiwipete = Parser::loadFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    auto endgame = Parser::loadFen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+    auto promotions = Parser::loadFen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+
+    for (Board *board: {&kiwipete, &endgame, &promotions}) board->enableAttackMaps();
+
+    REQUIRE(Perft::perft(kiwipete, 3) == 97862);
+    REQUIRE(Perft::perft(endgame, 5) == 674624);
+    REQUIRE(Perft::perft(promotions, 3) == 9467);
+
+    // make/unmake left the maps equal to a fresh computation
+    Board fresh = kiwipete;
+    fresh.enableAttackMaps();
+    REQUIRE(fresh.getAttackedBy(WHITE) == kiwipete.getAttackedBy(WHITE));
+    REQUIRE(fresh.getAttackedBy(BLACK) == kiwipete.getAttackedBy(BLACK));
+}
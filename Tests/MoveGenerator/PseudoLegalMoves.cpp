@@ -5,7 +5,7 @@
 #include "../../MoveGenerator/PreComputedMoves/PreComputedMoves.hpp"
 #include "../../MoveGenerator/PseudoLegalMovesGenerator/PseudoLegalMovesGenerator.hpp"
 
-const auto precomputed = PreComputedMovesGenerator::generate();
+const auto &precomputed = PreComputedMovesGenerator::instance();
 
 TEST_CASE("Test all fields attacked by color", "[white][attacks]") {
     const std::string fen = "rrnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 1";
@@ -27,5 +27,20 @@ TEST_CASE("Count all pseudo legal moves (from start position is 20 legal moves a
         board
     );
 
-    REQUIRE(result.m.size() == 20);
+    REQUIRE(result.size() == 20);
+}
+
+TEST_CASE("Fill attack map equals the lookup attack map", "[attacks][fill]") {
+    for (const auto &fen: {
+             "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+             "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+             "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+         }) {
+        const auto board = Parser::loadFen(fen);
+
+        for (const auto color: {PieceColor::WHITE, PieceColor::BLACK}) {
+            REQUIRE(PseudoLegalMovesGenerator::getFieldsAttackedByColorFill(color, board) ==
+                    PseudoLegalMovesGenerator::getFieldsAttackedByColor(color, board));
+        }
+    }
 }
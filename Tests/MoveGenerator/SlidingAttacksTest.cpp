@@ -6,7 +6,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include "../../MoveGenerator/PieceRelevantFieldsMask/RookRelevantMoveMask.hpp"
-#include "../../MoveGenerator/PreComputedMoves/MagicBoardIndexGenerator.hpp"
+#include "../../MoveGenerator/PieceSlidingAttack/FillSlidingAttack.hpp"
 #include "../../MoveGenerator/PreComputedMoves/PreComputedMoves.hpp"
 #include "../../MoveGenerator/Move/Move.hpp"
 
@@ -14,7 +14,7 @@
 using namespace Bitboards;
 using namespace Move;
 
-const auto precomputed = PreComputedMovesGenerator::instance();
+const auto &precomputed = PreComputedMovesGenerator::instance();
 
 TEST_CASE("Sliding Precomputed Rook Attacks", "[Rook sliding Attacks]") {
     const int sqR = 27; // white rook on d4
@@ -28,11 +28,7 @@ TEST_CASE("Sliding Precomputed Rook Attacks", "[Rook sliding Attacks]") {
     white |= Bitboards::bit(25) | Bitboards::bit(27);
     BitBoard occAll = white | black;
 
-    BitBoard mask = RookRelevantMoveMask::generateRelevantFieldsMask(sqR);
-    BitBoard relevant = occAll & mask;
-    const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-    BitBoard attacks = precomputed.rook[sqR][idx];
+    BitBoard attacks = precomputed.getRookAttacks(sqR, occAll);
     BitBoard legalPseudo = attacks & ~white;
 
     REQUIRE(legalPseudo == 0x80834080800);
@@ -45,7 +41,7 @@ TEST_CASE("Sliding Precomputed Rook Attacks", "[Rook sliding Attacks]") {
         movesQueue
     );
 
-    REQUIRE(movesQueue.m.size() == 7);
+    REQUIRE(movesQueue.size() == 7);
 }
 
 TEST_CASE("Sliding Precomputed Bishop Attacks", "[Bishop sliding Attacks]") {
@@ -60,11 +56,7 @@ TEST_CASE("Sliding Precomputed Bishop Attacks", "[Bishop sliding Attacks]") {
     white |= Bitboards::bit(25) | Bitboards::bit(27);
     BitBoard occAll = white | black;
 
-    BitBoard mask = BishopRelevantMoveMask::generateRelevantFieldsMask(sqR);
-    BitBoard relevant = occAll & mask;
-    const auto idx = MagicBoardIndexGenerator::getId(relevant, mask);
-
-    BitBoard attacks = precomputed.bishop[sqR][idx];
+    BitBoard attacks = precomputed.getBishopAttacks(sqR, occAll);
     BitBoard legalPseudo = attacks & ~white;
 
     REQUIRE(legalPseudo == 0x8041221400142241);
@@ -77,5 +69,50 @@ TEST_CASE("Sliding Precomputed Bishop Attacks", "[Bishop sliding Attacks]") {
         movesQueue
     );
 
-    REQUIRE(movesQueue.m.size() == 13);
+    REQUIRE(movesQueue.size() == 13);
+}
+
+TEST_CASE("Slider table lookups match ray generation", "[Sliding Attacks]") {
+    BitBoard state = 0x123456789ABCDEFULL;
+
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        for (int i = 0; i < 64; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const BitBoard occupancy = state & (state >> 7);
+
+            REQUIRE(precomputed.getRookAttacks(sq, occupancy) ==
+                    RookSlidingAttack::generateSlidingAttacks(sq, occupancy));
+            REQUIRE(precomputed.getBishopAttacks(sq, occupancy) ==
+                    BishopSlidingAttack::generateSlidingAttacks(sq, occupancy));
+        }
+    }
+}
+
+TEST_CASE("Fill attacks of slider sets match per piece lookups", "[Sliding Attacks][fill]") {
+    BitBoard state = 0xFEDCBA9876543210ULL;
+
+    for (int i = 0; i < 4096; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const BitBoard occupancy = state & (state >> 7);
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const BitBoard rooks = occupancy & state & (state >> 13);
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const BitBoard bishops = occupancy & state & (state >> 17);
+
+        BitBoard expected = 0;
+        for (BitBoard temp = rooks; temp; pop_lsb(temp)) {
+            expected |= precomputed.getRookAttacks(lsb_index(temp), occupancy);
+        }
+        for (BitBoard temp = bishops; temp; pop_lsb(temp)) {
+            expected |= precomputed.getBishopAttacks(lsb_index(temp), occupancy);
+        }
+
+        REQUIRE(FillSlidingAttack::getAttacksScalar(rooks, bishops, occupancy) == expected);
+        REQUIRE(FillSlidingAttack::getAttacks(rooks, bishops, occupancy) == expected);
+#if defined(__GNUC__) && defined(__x86_64__)
+        if (FillSlidingAttack::detectMode() == FillSlidingAttack::Mode::AVX2) {
+            REQUIRE(FillSlidingAttack::getAttacksAvx2(rooks, bishops, occupancy) == expected);
+        }
+#endif
+    }
 }
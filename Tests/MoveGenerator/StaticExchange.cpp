@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../Parser/Parser.cpp"
+#include "../../MoveGenerator/StaticExchange/StaticExchange.hpp"
+
+TEST_CASE("Attackers of a square include both colors", "[see][attackers]") {
+    const auto board = Parser::loadFen("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+
+    // e5: white rook e1, no black defender
+    REQUIRE(PseudoLegalMovesGenerator::attackersTo(board, 36, board.occupancyAll) == Bitboards::bit(4));
+    // d6: black pawn c7 and black rook d8
+    REQUIRE(PseudoLegalMovesGenerator::attackersTo(board, 43, board.occupancyAll) ==
+            (Bitboards::bit(59) | Bitboards::bit(50)));
+}
+
+TEST_CASE("SEE of an undefended pawn is the pawn", "[see]") {
+    const auto board = Parser::loadFen("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+
+    REQUIRE(StaticExchange::evaluate(board, Move::encodeMove(4, 36)) == PieceSquareTables::VALUE[PAWN]);
+}
+
+TEST_CASE("SEE follows x-rays behind the first attackers", "[see][xray]") {
+    const auto board = Parser::loadFen("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+
+    // Nd3xe5 is answered by Nd7xe5, the white rook and queen behind each other cannot win it back
+    REQUIRE(StaticExchange::evaluate(board, Move::encodeMove(19, 36)) ==
+            PieceSquareTables::VALUE[PAWN] - PieceSquareTables::VALUE[KNIGHT]);
+}
+
+TEST_CASE("SEE of a defended queen capture by a pawn", "[see]") {
+    const auto board = Parser::loadFen("4k3/8/3p4/4q3/3P4/8/8/4K3 w - - 0 1");
+
+    // dxe5 wins the queen, dxe5 gives back a pawn
+    REQUIRE(StaticExchange::evaluate(board, Move::encodeMove(27, 36)) ==
+            PieceSquareTables::VALUE[QUEEN] - PieceSquareTables::VALUE[PAWN]);
+    REQUIRE(StaticExchange::isAtLeast(board, Move::encodeMove(27, 36), 0));
+}
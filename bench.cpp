@@ -0,0 +1,289 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Engine/Engine.hpp"
+#include "Engine/Utils/SearchConfig.hpp"
+#include "Engine/Utils/SearchLimits.hpp"
+#include "MoveGenerator/Perft/Perft.hpp"
+#include "MoveGenerator/PieceSlidingAttack/FillSlidingAttack.hpp"
+#include "MoveGenerator/PseudoLegalMovesGenerator/PseudoLegalMovesGenerator.hpp"
+#include "Parser/Parser.cpp"
+
+namespace {
+    const std::string benchPositions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+
+    int runSearchBench(const int depth, const unsigned threads) {
+        SearchConfig config;
+        config.maxDepth = depth;
+        config.threads = threads;
+        config.splitMinDepth = 2;
+        config.splitMinMoves = 16;
+
+        uint64_t totalNodes = 0;
+        double totalSeconds = 0.0;
+
+        for (const auto &fen: benchPositions) {
+            auto board = Parser::loadFen(fen);
+            TranspositionTable table{64};
+
+            SearchLimits limits;
+            const auto start = std::chrono::steady_clock::now();
+
+            // time to depth
+            config.onIteration = [&start, &limits](const IterationInfo &info) {
+                const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << "  depth " << info.depth << " score " << info.score
+                        << " nodes " << limits.nodes() << " time " << elapsed << "s" << std::endl;
+            };
+            const auto [score, bestMove] = Engine::run(board, config, table, limits);
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const auto nodes = limits.nodes();
+
+            totalNodes += nodes;
+            totalSeconds += elapsed;
+
+            std::cout << fen << "\n  score " << score
+                    << " move " << static_cast<int>(Move::moveFrom(bestMove)) << "->"
+                    << static_cast<int>(Move::moveTo(bestMove))
+                    << " nodes " << nodes
+                    << " time " << elapsed << "s"
+                    << " nps " << static_cast<uint64_t>(nodes / elapsed) << std::endl;
+        }
+
+        std::cout << "\ntotal nodes " << totalNodes
+                << " time " << totalSeconds << "s"
+                << " nps " << static_cast<uint64_t>(totalNodes / totalSeconds) << std::endl;
+        return 0;
+    }
+
+    // mobility and king zone pressure of both colors, derived from whole board attack maps
+    template<typename AttackMap>
+    uint64_t attackQueries(const Board &board, AttackMap attackMap) {
+        uint64_t result = 0;
+
+        for (const auto color: {WHITE, BLACK}) {
+            const auto them = color == WHITE ? BLACK : WHITE;
+            const BitBoard attacks = attackMap(color, board);
+            const BitBoard kingZone = preComputedMoves.king[Bitboards::lsb_index(board.pieces[them][PieceType::KING])];
+
+            result += Bitboards::popCount64(attacks & ~board.occupancy[color]);
+            result += Bitboards::popCount64(attacks & kingZone) << 8;
+        }
+
+        return result;
+    }
+
+    template<typename AttackMap>
+    void timeAttackQueries(const char *name, const std::vector<Board> &boards, const int iterations,
+                           AttackMap attackMap) {
+        uint64_t checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            for (const auto &board: boards) checksum += attackQueries(board, attackMap);
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto queries = static_cast<double>(iterations) * static_cast<double>(boards.size()) * 2.0;
+
+        std::cout << name << ": " << elapsed * 1e9 / queries << " ns per color map, checksum " << checksum
+                << std::endl;
+    }
+
+    int runAttackBench(const int iterations) {
+        std::vector<Board> boards;
+        for (const auto &fen: benchPositions) boards.push_back(Parser::loadFen(fen));
+
+        std::cout << "fill mode " << (FillSlidingAttack::detectMode() == FillSlidingAttack::Mode::AVX2
+                                          ? "avx2"
+                                          : "scalar") << std::endl;
+
+        timeAttackQueries("lookup", boards, iterations, [](const PieceColor color, const Board &board) {
+            return PseudoLegalMovesGenerator::getFieldsAttackedByColor(color, board);
+        });
+        timeAttackQueries("fill", boards, iterations, [](const PieceColor color, const Board &board) {
+            return PseudoLegalMovesGenerator::getFieldsAttackedByColorFill(color, board);
+        });
+
+        // sliders only, the part the two maps differ in
+        const auto sliders = [](const PieceColor color, const Board &board, auto kernel) {
+            const BitBoard queens = board.pieces[color][PieceType::QUEEN];
+            return kernel(board.pieces[color][PieceType::ROOK] | queens,
+                          board.pieces[color][PieceType::BISHOP] | queens, board.occupancyAll);
+        };
+
+        timeAttackQueries("sliders lookup", boards, iterations, [&](const PieceColor color, const Board &board) {
+            return sliders(color, board, [](BitBoard rooks, BitBoard bishops, const BitBoard &occupancy) {
+                BitBoard attacks = 0;
+                for (; rooks; Bitboards::pop_lsb(rooks))
+                    attacks |= preComputedMoves.getRookAttacks(Bitboards::lsb_index(rooks), occupancy);
+                for (; bishops; Bitboards::pop_lsb(bishops))
+                    attacks |= preComputedMoves.getBishopAttacks(Bitboards::lsb_index(bishops), occupancy);
+                return attacks;
+            });
+        });
+        timeAttackQueries("sliders fill scalar", boards, iterations, [&](const PieceColor color, const Board &board) {
+            return sliders(color, board, FillSlidingAttack::getAttacksScalar);
+        });
+        timeAttackQueries("sliders fill", boards, iterations, [&](const PieceColor color, const Board &board) {
+            return sliders(color, board, FillSlidingAttack::getAttacks);
+        });
+
+        return 0;
+    }
+
+    // perft with king danger and check tests recomputed from scratch vs read from the board attack maps
+    int runAttackMapBench(const int depth) {
+        for (const bool incremental: {false, true}) {
+            uint64_t totalNodes = 0;
+            double totalSeconds = 0.0;
+
+            for (const auto &fen: benchPositions) {
+                auto board = Parser::loadFen(fen);
+                if (incremental) board.enableAttackMaps();
+
+                const auto start = std::chrono::steady_clock::now();
+                totalNodes += Perft::perft(board, depth);
+                totalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            std::cout << (incremental ? "incremental maps" : "recompute") << ": nodes " << totalNodes
+                    << " time " << totalSeconds << "s"
+                    << " nps " << static_cast<uint64_t>(totalNodes / totalSeconds) << std::endl;
+        }
+
+        return 0;
+    }
+
+    // make/unmake of every legal move of the bench positions, nothing else
+    int runMakeMoveBench(const int iterations) {
+        uint64_t pairs = 0;
+        BitBoard checksum = 0;
+        double totalSeconds = 0.0;
+
+        for (const auto &fen: benchPositions) {
+            auto board = Parser::loadFen(fen);
+            const auto moves = LegalMovesGenerator::generateLegalMoves(board);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) {
+                for (const auto &move: moves) {
+                    UndoInfo undo;
+                    MoveExecutor::makeMove(board, move, undo);
+                    checksum += board.zobrist;
+                    MoveExecutor::unmakeMove(board, move, undo);
+                }
+            }
+            totalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            pairs += static_cast<uint64_t>(iterations) * moves.size();
+        }
+
+        std::cout << "make/unmake pairs " << pairs
+                << " time " << totalSeconds << "s"
+                << " ns per pair " << totalSeconds * 1e9 / static_cast<double>(pairs)
+                << " checksum " << checksum << std::endl;
+        return 0;
+    }
+
+    // Win At Chess positions with a single best move, given as from and to squares
+    const std::pair<std::string, std::string> tacticalPositions[] = {
+        {"2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1", "g3g6"},
+        {"8/7p/5k2/5p2/p1p2P2/Pr1pPK2/1P1R3P/8 b - - 0 1", "b3b2"},
+        {"5rk1/1ppb3p/p1pb4/6q1/3P1p1r/2P1R2P/PP1BQ1P1/5RKN w - - 0 1", "e3g3"},
+        {"r1bq2rk/pp3pbp/2p1p1pQ/7P/3P4/2PB1N2/PP3PPR/2KR4 w - - 0 1", "h6h7"},
+        {"5k2/6pp/p1qN4/1p1p4/3P4/2PKP2Q/PP3r2/3R4 b - - 0 1", "c6c4"},
+        {"r4q1k/p2bR1rp/2p2Q1N/5p2/5p2/2P5/PP3PPP/R5K1 w - - 0 1", "e7f7"},
+        {"2br2k1/2q3rn/p2NppQ1/2p1P3/Pp5R/4P3/1P3PPP/3R2K1 w - - 0 1", "h4h7"},
+    };
+
+    std::string squareName(const int square) {
+        return {static_cast<char>('a' + square % 8), static_cast<char>('1' + square / 8)};
+    }
+
+    // time and nodes until the expected move is chosen by every later iteration
+    int runTacticsBench(const int depth, const unsigned threads) {
+        SearchConfig config;
+        config.maxDepth = depth;
+        config.threads = threads;
+        config.splitMinDepth = 2;
+        config.splitMinMoves = 16;
+
+        int solved = 0;
+        uint64_t totalNodes = 0;
+        double totalSeconds = 0.0;
+
+        for (const auto &[fen, expected]: tacticalPositions) {
+            auto board = Parser::loadFen(fen);
+            TranspositionTable table{64};
+
+            int solvedDepth = 0;
+            uint64_t solvedNodes = 0;
+            double solvedSeconds = 0.0;
+
+            SearchLimits limits;
+            const auto start = std::chrono::steady_clock::now();
+            config.onIteration = [&](const IterationInfo &info) {
+                const auto move = squareName(Move::moveFrom(info.bestMove)) + squareName(Move::moveTo(info.bestMove));
+                if (move != expected) {
+                    solvedDepth = 0;
+                } else if (!solvedDepth) {
+                    solvedDepth = info.depth;
+                    solvedNodes = limits.nodes();
+                    solvedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                }
+            };
+            Engine::run(board, config, table, limits);
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            totalNodes += limits.nodes();
+            totalSeconds += elapsed;
+
+            std::cout << fen << " " << expected;
+            if (solvedDepth) {
+                solved++;
+                std::cout << "\n  solved at depth " << solvedDepth << " nodes " << solvedNodes
+                        << " time " << solvedSeconds << "s";
+            } else {
+                std::cout << "\n  not solved";
+            }
+            std::cout << " (total nodes " << limits.nodes() << " time " << elapsed << "s)" << std::endl;
+        }
+
+        std::cout << "\nsolved " << solved << "/" << std::size(tacticalPositions)
+                << " total nodes " << totalNodes << " time " << totalSeconds << "s" << std::endl;
+        return 0;
+    }
+}
+
+// usage: bench [depth] [threads]
+//        bench tactics [depth] [threads]
+//        bench attacks [iterations]
+//        bench attackmaps [depth]
+//        bench makemove [iterations]
+int main(const int argc, char **argv) {
+    if (argc > 1 && std::string(argv[1]) == "attacks") {
+        return runAttackBench(argc > 2 ? std::stoi(argv[2]) : 2000000);
+    }
+    if (argc > 1 && std::string(argv[1]) == "makemove") {
+        return runMakeMoveBench(argc > 2 ? std::stoi(argv[2]) : 200000);
+    }
+    if (argc > 1 && std::string(argv[1]) == "tactics") {
+        return runTacticsBench(argc > 2 ? std::stoi(argv[2]) : 7,
+                               argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "attackmaps") {
+        return runAttackMapBench(argc > 2 ? std::stoi(argv[2]) : 5);
+    }
+
+    const int depth = argc > 1 ? std::stoi(argv[1]) : 4;
+    const unsigned threads = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 8;
+
+    return runSearchBench(depth, threads);
+}
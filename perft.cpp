@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "MoveGenerator/Perft/Perft.hpp"
+#include "MoveGenerator/Perft/PerftTable.hpp"
+#include "Engine/ThreadPool/ThreadPool.hpp"
+#include "Parser/Parser.cpp"
+
+namespace {
+    struct PerftPosition {
+        const char *name;
+        const char *fen;
+        // known leaf counts for depth 1..6, 0 when not listed
+        uint64_t expected[6];
+    };
+
+    const PerftPosition perftPositions[] = {
+        {
+            "startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            {20, 400, 8902, 197281, 4865609, 119060324}
+        },
+        {
+            "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            {48, 2039, 97862, 4085603, 193690690, 8031647685}
+        },
+        {
+            "position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            {14, 191, 2812, 43238, 674624, 11030083}
+        },
+        {
+            "position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            {6, 264, 9467, 422333, 15833292, 706045033}
+        },
+        {
+            "position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+            {44, 1486, 62379, 2103487, 89941194, 3048196529}
+        },
+        {
+            "position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+            {46, 2079, 89890, 3894594, 164075551, 6923051137}
+        },
+    };
+
+    uint64_t runPerft(Board &board, const int depth, PerftTable *table, ThreadPool *pool) {
+        if (pool) return Perft::perftParallel(*pool, board, depth, table);
+        return Perft::perft(board, depth, table);
+    }
+
+    int runSuite(const int depth, PerftTable *table, ThreadPool *pool) {
+        uint64_t totalNodes = 0;
+        double totalSeconds = 0.0;
+        bool ok = true;
+
+        for (const auto &position: perftPositions) {
+            auto board = Parser::loadFen(position.fen);
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto nodes = runPerft(board, depth, table, pool);
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const uint64_t expected = depth >= 1 && depth <= 6 ? position.expected[depth - 1] : 0;
+            const bool matches = !expected || nodes == expected;
+            ok &= matches;
+
+            totalNodes += nodes;
+            totalSeconds += elapsed;
+
+            std::cout << position.name << " depth " << depth
+                    << " nodes " << nodes
+                    << " time " << elapsed << "s"
+                    << " nps " << static_cast<uint64_t>(nodes / elapsed)
+                    << (matches ? "" : " MISMATCH expected " + std::to_string(expected)) << std::endl;
+        }
+
+        std::cout << "\ntotal nodes " << totalNodes
+                << " time " << totalSeconds << "s"
+                << " nps " << static_cast<uint64_t>(totalNodes / totalSeconds) << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    int runDivide(const std::string &fen, const int depth, PerftTable *table, ThreadPool *pool) {
+        auto board = Parser::loadFen(fen);
+        uint64_t total = 0;
+
+        const auto divided = pool ? Perft::divideParallel(*pool, board, depth, table) : Perft::divide(board, depth, table);
+        for (const auto &[move, nodes]: divided) {
+            std::cout << Move::toUci(move) << ": " << nodes << std::endl;
+            total += nodes;
+        }
+
+        std::cout << "\nnodes " << total << std::endl;
+        return 0;
+    }
+}
+
+// usage: perft [depth] [hashMb] [threads]
+//        perft divide <depth> "<fen>" [hashMb] [threads]
+// hashMb = 0 disables the subtree hash, threads > 1 splits the subtrees over a ThreadPool
+int main(const int argc, char **argv) {
+    const bool divide = argc > 1 && std::strcmp(argv[1], "divide") == 0;
+    const int first = divide ? 2 : 1;
+
+    const int depth = argc > first ? std::stoi(argv[first]) : 5;
+    const int hashArg = divide ? first + 2 : first + 1;
+    const size_t hashMb = argc > hashArg ? std::stoul(argv[hashArg]) : 0;
+    const unsigned threads = argc > hashArg + 1 ? static_cast<unsigned>(std::stoul(argv[hashArg + 1])) : 1;
+
+    std::unique_ptr<PerftTable> table;
+    if (hashMb) table = std::make_unique<PerftTable>(hashMb);
+
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) pool = std::make_unique<ThreadPool>(threads);
+
+    if (divide) {
+        if (argc <= first + 1) {
+            std::cerr << "usage: perft divide <depth> \"<fen>\" [hashMb] [threads]" << std::endl;
+            return 1;
+        }
+        return runDivide(argv[first + 1], depth, table.get(), pool.get());
+    }
+
+    return runSuite(depth, table.get(), pool.get());
+}